@@ -22,6 +22,87 @@ import { Channel } from './channel';
 import { BaseFilter, Filter, FilterFactory } from './filter';
 import { Metadata, MetadataValue } from './metadata';
 
+/* Messages up to this size are compressed synchronously, and compressed
+ * messages that inflate to at most this size are decompressed synchronously,
+ * because for them dispatching the work to the libuv threadpool and back
+ * costs more than the work itself. Anything larger still uses the async APIs
+ * so that it does not block the event loop. */
+const MAX_SYNC_COMPRESSION_SIZE = 4096;
+
+type ZlibSyncMethod = (data: Buffer, options?: zlib.ZlibOptions) => Buffer;
+type ZlibAsyncMethod = (
+  data: Buffer,
+  callback: (error: Error | null, result: Buffer) => void
+) => void;
+
+/* The sync APIs only stop at maxOutputLength since Node 12.19 and 14.5, and
+ * older versions ignore it. A small payload can inflate to many megabytes, so
+ * without that limit every message is decompressed asynchronously. */
+const SYNC_DECOMPRESSION_IS_BOUNDED = (() => {
+  try {
+    zlib.inflateSync(zlib.deflateSync(Buffer.alloc(2)), {
+      maxOutputLength: 1,
+    } as zlib.ZlibOptions);
+    return false;
+  } catch (err) {
+    return true;
+  }
+})();
+
+function runZlibAsync(method: ZlibAsyncMethod, data: Buffer): Promise<Buffer> {
+  return new Promise<Buffer>((resolve, reject) => {
+    method(data, (err, output) => {
+      if (err) {
+        reject(err);
+      } else {
+        resolve(output);
+      }
+    });
+  });
+}
+
+function compress(
+  syncMethod: ZlibSyncMethod,
+  asyncMethod: ZlibAsyncMethod,
+  message: Buffer
+): Promise<Buffer> {
+  if (message.length > MAX_SYNC_COMPRESSION_SIZE) {
+    return runZlibAsync(asyncMethod, message);
+  }
+  try {
+    return Promise.resolve(syncMethod(message));
+  } catch (err) {
+    return Promise.reject(err);
+  }
+}
+
+function decompress(
+  syncMethod: ZlibSyncMethod,
+  asyncMethod: ZlibAsyncMethod,
+  data: Buffer
+): Promise<Buffer> {
+  /* Compressed input that is already larger than the limit almost never
+   * inflates to less than it, so it is not worth trying synchronously. */
+  if (
+    SYNC_DECOMPRESSION_IS_BOUNDED &&
+    data.length <= MAX_SYNC_COMPRESSION_SIZE
+  ) {
+    try {
+      return Promise.resolve(
+        syncMethod(data, {
+          maxOutputLength: MAX_SYNC_COMPRESSION_SIZE,
+        } as zlib.ZlibOptions)
+      );
+    } catch (err) {
+      if (err.code !== 'ERR_BUFFER_TOO_LARGE') {
+        return Promise.reject(err);
+      }
+      // The output is too large to produce synchronously, so start over
+    }
+  }
+  return runZlibAsync(asyncMethod, data);
+}
+
 abstract class CompressionHandler {
   protected abstract compressMessage(message: Buffer): Promise<Buffer>;
   protected abstract decompressMessage(data: Buffer): Promise<Buffer>;
@@ -81,53 +162,21 @@ class IdentityHandler extends CompressionHandler {
 
 class DeflateHandler extends CompressionHandler {
   compressMessage(message: Buffer) {
-    return new Promise<Buffer>((resolve, reject) => {
-      zlib.deflate(message, (err, output) => {
-        if (err) {
-          reject(err);
-        } else {
-          resolve(output);
-        }
-      });
-    });
+    return compress(zlib.deflateSync, zlib.deflate, message);
   }
 
   decompressMessage(message: Buffer) {
-    return new Promise<Buffer>((resolve, reject) => {
-      zlib.inflate(message, (err, output) => {
-        if (err) {
-          reject(err);
-        } else {
-          resolve(output);
-        }
-      });
-    });
+    return decompress(zlib.inflateSync, zlib.inflate, message);
   }
 }
 
 class GzipHandler extends CompressionHandler {
   compressMessage(message: Buffer) {
-    return new Promise<Buffer>((resolve, reject) => {
-      zlib.gzip(message, (err, output) => {
-        if (err) {
-          reject(err);
-        } else {
-          resolve(output);
-        }
-      });
-    });
+    return compress(zlib.gzipSync, zlib.gzip, message);
   }
 
   decompressMessage(message: Buffer) {
-    return new Promise<Buffer>((resolve, reject) => {
-      zlib.unzip(message, (err, output) => {
-        if (err) {
-          reject(err);
-        } else {
-          resolve(output);
-        }
-      });
-    });
+    return decompress(zlib.unzipSync, zlib.unzip, message);
   }
 }
 
@@ -18,6 +18,7 @@
 import { Call } from './call-stream';
 import { ConnectivityState, Http2Channel } from './channel';
 import { Status } from './constants';
+import { deadlineWheel } from './deadline-wheel';
 import { BaseFilter, Filter, FilterFactory } from './filter';
 import { Metadata } from './metadata';
 
@@ -41,7 +42,6 @@ function getDeadline(deadline: number) {
 }
 
 export class DeadlineFilter extends BaseFilter implements Filter {
-  private timer: NodeJS.Timer | null = null;
   private deadline: number;
   constructor(
     private readonly channel: Http2Channel,
@@ -54,19 +54,14 @@ export class DeadlineFilter extends BaseFilter implements Filter {
     } else {
       this.deadline = callDeadline;
     }
-    const now: number = new Date().getTime();
-    let timeout = this.deadline - now;
-    if (timeout < 0) {
-      timeout = 0;
-    }
     if (this.deadline !== Infinity) {
-      this.timer = setTimeout(() => {
+      const entry = deadlineWheel.add(this.deadline, () => {
         callStream.cancelWithStatus(
           Status.DEADLINE_EXCEEDED,
           'Deadline exceeded'
         );
-      }, timeout);
-      callStream.on('status', () => clearTimeout(this.timer as NodeJS.Timer));
+      });
+      callStream.on('status', () => deadlineWheel.remove(entry));
     }
   }
 
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * The granularity of the deadline wheel. Deadlines are rounded up to a
+ * multiple of this, so they fire at most this late and never early.
+ */
+const DEFAULT_TICK_MS = 10;
+
+// setTimeout fires immediately when given a larger delay than this
+const MAX_TIMER_DELAY_MS = 2 ** 31 - 1;
+
+export interface DeadlineEntry {
+  readonly tick: number;
+  readonly callback: () => void;
+}
+
+/**
+ * Groups deadlines into coarse ticks and expires each tick's deadlines
+ * together, so that many calls share a single timer instead of each arming
+ * and clearing its own.
+ */
+export class DeadlineWheel {
+  private buckets = new Map<number, Set<DeadlineEntry>>();
+  /* A min-heap of the ticks that have buckets. Each tick is in it exactly
+   * once, even after all of its entries are removed */
+  private ticks: number[] = [];
+  private timer: NodeJS.Timer | null = null;
+  private armedTick = Infinity;
+  private size = 0;
+
+  constructor(private readonly tickMs = DEFAULT_TICK_MS) {}
+
+  /**
+   * Call callback once the time reaches deadline, in milliseconds since the
+   * epoch, unless the returned entry is removed first.
+   */
+  add(deadline: number, callback: () => void): DeadlineEntry {
+    const tick = Math.ceil(deadline / this.tickMs);
+    const entry: DeadlineEntry = { tick, callback };
+    let bucket = this.buckets.get(tick);
+    if (bucket === undefined) {
+      bucket = new Set();
+      this.buckets.set(tick, bucket);
+      this.pushTick(tick);
+    }
+    bucket.add(entry);
+    this.size += 1;
+    if (tick < this.armedTick) {
+      this.arm(tick);
+    }
+    return entry;
+  }
+
+  remove(entry: DeadlineEntry) {
+    const bucket = this.buckets.get(entry.tick);
+    if (bucket === undefined || !bucket.delete(entry)) {
+      return;
+    }
+    this.size -= 1;
+    if (this.size === 0) {
+      // Like a cleared timer, an empty wheel does not keep the process alive
+      this.disarm();
+      this.reset();
+    }
+  }
+
+  private reset() {
+    this.buckets.clear();
+    this.ticks = [];
+  }
+
+  private arm(tick: number) {
+    this.disarm();
+    this.armedTick = tick;
+    const delay = Math.min(
+      Math.max(tick * this.tickMs - Date.now(), 0),
+      MAX_TIMER_DELAY_MS
+    );
+    this.timer = setTimeout(() => this.expire(), delay);
+  }
+
+  private disarm() {
+    if (this.timer !== null) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    this.armedTick = Infinity;
+  }
+
+  private expire() {
+    this.timer = null;
+    this.armedTick = Infinity;
+    const nowTick = Date.now() / this.tickMs;
+    while (this.ticks.length > 0 && this.ticks[0] <= nowTick) {
+      const tick = this.popTick();
+      const bucket = this.buckets.get(tick)!;
+      this.buckets.delete(tick);
+      this.size -= bucket.size;
+      for (const entry of bucket) {
+        entry.callback();
+      }
+    }
+    if (this.size === 0) {
+      // Only empty buckets are left, so they do not need a timer
+      this.reset();
+    } else if (this.armedTick === Infinity) {
+      this.arm(this.ticks[0]);
+    }
+  }
+
+  private pushTick(tick: number) {
+    const ticks = this.ticks;
+    let index = ticks.push(tick) - 1;
+    while (index > 0) {
+      const parent = (index - 1) >> 1;
+      if (ticks[parent] <= tick) {
+        break;
+      }
+      ticks[index] = ticks[parent];
+      index = parent;
+    }
+    ticks[index] = tick;
+  }
+
+  private popTick(): number {
+    const ticks = this.ticks;
+    const top = ticks[0];
+    const last = ticks.pop()!;
+    if (ticks.length > 0) {
+      let index = 0;
+      for (;;) {
+        let child = 2 * index + 1;
+        if (child >= ticks.length) {
+          break;
+        }
+        if (child + 1 < ticks.length && ticks[child + 1] < ticks[child]) {
+          child += 1;
+        }
+        if (ticks[child] >= last) {
+          break;
+        }
+        ticks[index] = ticks[child];
+        index = child;
+      }
+      ticks[index] = last;
+    }
+    return top;
+  }
+}
+
+/**
+ * The wheel shared by every call's deadline.
+ */
+export const deadlineWheel = new DeadlineWheel();
@@ -21,56 +21,76 @@ enum ReadState {
   READING_MESSAGE,
 }
 
+const HEADER_LENGTH = 5;
+
 export class StreamDecoder {
   private readState: ReadState = ReadState.NO_DATA;
-  private readCompressFlag: Buffer = Buffer.alloc(1);
-  private readPartialSize: Buffer = Buffer.alloc(4);
-  private readSizeRemaining = 4;
-  private readMessageSize = 0;
+  /* Holds the compression flag and message size while they are split across
+   * chunks. */
+  private readPartialHeader: Buffer = Buffer.alloc(HEADER_LENGTH);
+  private readHeaderRemaining = HEADER_LENGTH;
+  /* Holds views of the parts of a framed message that is split across
+   * chunks. They are copied once, when the whole message has arrived, so that
+   * memory is only used for bytes that were actually received, whatever size
+   * the peer declares. */
   private readPartialMessage: Buffer[] = [];
+  private readMessageLength = 0;
   private readMessageRemaining = 0;
 
   write(data: Buffer): Buffer[] {
     let readHead = 0;
     let toRead: number;
+    let framedLength: number;
     const result: Buffer[] = [];
 
     while (readHead < data.length) {
       switch (this.readState) {
         case ReadState.NO_DATA:
-          this.readCompressFlag = data.slice(readHead, readHead + 1);
-          readHead += 1;
-          this.readState = ReadState.READING_SIZE;
-          this.readPartialSize.fill(0);
-          this.readSizeRemaining = 4;
-          this.readMessageSize = 0;
-          this.readMessageRemaining = 0;
-          this.readPartialMessage = [];
+          toRead = data.length - readHead;
+          if (toRead < HEADER_LENGTH) {
+            data.copy(this.readPartialHeader, 0, readHead);
+            this.readHeaderRemaining = HEADER_LENGTH - toRead;
+            readHead += toRead;
+            this.readState = ReadState.READING_SIZE;
+            break;
+          }
+          framedLength = HEADER_LENGTH + data.readUInt32BE(readHead + 1);
+          if (toRead >= framedLength) {
+            // The whole message is in this chunk, so return a view of it
+            result.push(data.slice(readHead, readHead + framedLength));
+            readHead += framedLength;
+          } else {
+            this.readPartialMessage = [data.slice(readHead)];
+            this.readMessageLength = framedLength;
+            this.readMessageRemaining = framedLength - toRead;
+            readHead += toRead;
+            this.readState = ReadState.READING_MESSAGE;
+          }
           break;
         case ReadState.READING_SIZE:
-          toRead = Math.min(data.length - readHead, this.readSizeRemaining);
+          toRead = Math.min(data.length - readHead, this.readHeaderRemaining);
           data.copy(
-            this.readPartialSize,
-            4 - this.readSizeRemaining,
+            this.readPartialHeader,
+            HEADER_LENGTH - this.readHeaderRemaining,
             readHead,
             readHead + toRead
           );
-          this.readSizeRemaining -= toRead;
+          this.readHeaderRemaining -= toRead;
           readHead += toRead;
-          // readSizeRemaining >=0 here
-          if (this.readSizeRemaining === 0) {
-            this.readMessageSize = this.readPartialSize.readUInt32BE(0);
-            this.readMessageRemaining = this.readMessageSize;
-            if (this.readMessageRemaining > 0) {
+          // readHeaderRemaining >=0 here
+          if (this.readHeaderRemaining === 0) {
+            framedLength =
+              HEADER_LENGTH + this.readPartialHeader.readUInt32BE(1);
+            // The header buffer is reused, so the message gets its own copy
+            const header = Buffer.from(this.readPartialHeader);
+            if (framedLength > HEADER_LENGTH) {
+              this.readPartialMessage = [header];
+              this.readMessageLength = framedLength;
+              this.readMessageRemaining = framedLength - HEADER_LENGTH;
               this.readState = ReadState.READING_MESSAGE;
             } else {
-              const message = Buffer.concat(
-                [this.readCompressFlag, this.readPartialSize],
-                5
-              );
-
               this.readState = ReadState.NO_DATA;
-              result.push(message);
+              result.push(header);
             }
           }
           break;
@@ -79,20 +99,13 @@ export class StreamDecoder {
           this.readPartialMessage.push(data.slice(readHead, readHead + toRead));
           this.readMessageRemaining -= toRead;
           readHead += toRead;
-          // readMessageRemaining >=0 here
           if (this.readMessageRemaining === 0) {
             // At this point, we have read a full message
-            const framedMessageBuffers = [
-              this.readCompressFlag,
-              this.readPartialSize,
-            ].concat(this.readPartialMessage);
-            const framedMessage = Buffer.concat(
-              framedMessageBuffers,
-              this.readMessageSize + 5
-            );
-
             this.readState = ReadState.NO_DATA;
-            result.push(framedMessage);
+            result.push(
+              Buffer.concat(this.readPartialMessage, this.readMessageLength)
+            );
+            this.readPartialMessage = [];
           }
           break;
         default:
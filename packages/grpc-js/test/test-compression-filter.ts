@@ -0,0 +1,118 @@
+/*
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+import * as assert from 'assert';
+import * as zlib from 'zlib';
+
+import { CompressionFilter } from '../src/compression-filter';
+import { Metadata } from '../src/metadata';
+
+function frame(body: Buffer): Buffer {
+  const framed = Buffer.alloc(5 + body.length);
+  framed.writeUInt8(1, 0);
+  framed.writeUInt32BE(body.length, 1);
+  body.copy(framed, 5);
+  return framed;
+}
+
+// Node versions before 12.19 cannot bound sync decompression
+const syncDecompressionIsBounded = (() => {
+  try {
+    zlib.unzipSync(zlib.gzipSync(Buffer.alloc(2)), {
+      maxOutputLength: 1,
+    } as zlib.ZlibOptions);
+    return false;
+  } catch (err) {
+    return true;
+  }
+})();
+
+async function gzipFilter(): Promise<CompressionFilter> {
+  const filter = new CompressionFilter();
+  const headers = new Metadata();
+  headers.set('grpc-encoding', 'gzip');
+  await filter.receiveMetadata(Promise.resolve(headers));
+  return filter;
+}
+
+describe('CompressionFilter', () => {
+  const realUnzip = zlib.unzip;
+  let asyncCalls: number;
+
+  beforeEach(() => {
+    asyncCalls = 0;
+    // tslint:disable-next-line:no-any
+    (zlib as any).unzip = (...args: any[]) => {
+      asyncCalls += 1;
+      // tslint:disable-next-line:no-any
+      return (realUnzip as any)(...args);
+    };
+  });
+
+  afterEach(() => {
+    // tslint:disable-next-line:no-any
+    (zlib as any).unzip = realUnzip;
+  });
+
+  it('decompresses small messages synchronously', async () => {
+    const message = Buffer.from('small message');
+    const filter = await gzipFilter();
+    const output = await filter.receiveMessage(
+      Promise.resolve(frame(zlib.gzipSync(message)))
+    );
+    assert.deepStrictEqual(output, message);
+    assert.strictEqual(asyncCalls, syncDecompressionIsBounded ? 0 : 1);
+  });
+
+  it('decompresses large messages asynchronously', async () => {
+    const message = Buffer.alloc(1 << 16);
+    for (let i = 0; i < message.length; i++) {
+      message[i] = (i * 7919) & 0xff;
+    }
+    const filter = await gzipFilter();
+    const output = await filter.receiveMessage(
+      Promise.resolve(frame(zlib.gzipSync(message)))
+    );
+    assert.deepStrictEqual(output, message);
+    assert.strictEqual(asyncCalls, 1);
+  });
+
+  it('decompresses highly compressible messages asynchronously', async () => {
+    const message = Buffer.alloc(1 << 22);
+    const compressed = zlib.gzipSync(message);
+    assert(compressed.length < 4096);
+    const filter = await gzipFilter();
+    const output = await filter.receiveMessage(
+      Promise.resolve(frame(compressed))
+    );
+    assert.deepStrictEqual(output, message);
+    assert.strictEqual(asyncCalls, 1);
+  });
+
+  it('rejects corrupt compressed messages', async () => {
+    const filter = await gzipFilter();
+    let rejected = false;
+    try {
+      await filter.receiveMessage(
+        Promise.resolve(frame(Buffer.from('corrupt')))
+      );
+    } catch (err) {
+      rejected = true;
+    }
+    assert(rejected);
+  });
+});
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+import * as assert from 'assert';
+
+import { DeadlineWheel } from '../src/deadline-wheel';
+
+describe('DeadlineWheel', () => {
+  it('expires deadlines in order and never early', done => {
+    const wheel = new DeadlineWheel(5);
+    const start = Date.now();
+    const expired: number[] = [];
+    for (const delay of [40, 0, 20, 20]) {
+      wheel.add(start + delay, () => {
+        assert(Date.now() >= start + delay);
+        expired.push(delay);
+        if (expired.length === 4) {
+          assert.deepStrictEqual(expired, [0, 20, 20, 40]);
+          done();
+        }
+      });
+    }
+  });
+
+  it('does not expire removed deadlines', done => {
+    const wheel = new DeadlineWheel(5);
+    const start = Date.now();
+    const removed = wheel.add(start + 10, () => {
+      assert.fail('Removed deadline expired');
+    });
+    wheel.add(start + 20, done);
+    wheel.remove(removed);
+  });
+
+  it('rearms for a deadline earlier than the current one', done => {
+    const wheel = new DeadlineWheel(5);
+    const start = Date.now();
+    let earlyExpired = false;
+    const late = wheel.add(start + 1000, () => {
+      assert.fail('Late deadline expired first');
+    });
+    wheel.add(start + 10, () => {
+      earlyExpired = true;
+    });
+    setTimeout(() => {
+      assert(earlyExpired);
+      wheel.remove(late);
+      done();
+    }, 50);
+  });
+});
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+import * as assert from 'assert';
+
+import { StreamDecoder } from '../src/stream-decoder';
+
+function frame(message: string, compressed = false): Buffer {
+  const body = Buffer.from(message);
+  const framed = Buffer.alloc(5 + body.length);
+  framed.writeUInt8(compressed ? 1 : 0, 0);
+  framed.writeUInt32BE(body.length, 1);
+  body.copy(framed, 5);
+  return framed;
+}
+
+describe('StreamDecoder', () => {
+  const messages = [frame('first'), frame(''), frame('third', true)];
+  const data = Buffer.concat(messages);
+
+  it('decodes messages contained in a single chunk', () => {
+    const decoder = new StreamDecoder();
+    assert.deepStrictEqual(decoder.write(data), messages);
+  });
+
+  it('returns views of the chunk for messages contained in it', () => {
+    const decoder = new StreamDecoder();
+    const result = decoder.write(data);
+    assert.strictEqual(result[0].buffer, data.buffer);
+  });
+
+  it('decodes messages split across chunks at any offset', () => {
+    for (let chunkSize = 1; chunkSize <= data.length; chunkSize++) {
+      const decoder = new StreamDecoder();
+      let result: Buffer[] = [];
+      for (let offset = 0; offset < data.length; offset += chunkSize) {
+        result = result.concat(
+          decoder.write(data.slice(offset, offset + chunkSize))
+        );
+      }
+      assert.deepStrictEqual(result, messages);
+    }
+  });
+
+  it('does not allocate the declared length of a partial message', () => {
+    for (const length of [0x7fffffff, 0xffffffff]) {
+      const header = Buffer.alloc(5);
+      header.writeUInt32BE(length, 1);
+      const decoder = new StreamDecoder();
+      const before = process.memoryUsage().external;
+      assert.deepStrictEqual(
+        decoder.write(Buffer.concat([header, Buffer.from([1])])),
+        []
+      );
+      assert.deepStrictEqual(decoder.write(Buffer.alloc(1024)), []);
+      assert(process.memoryUsage().external - before < 1 << 20);
+    }
+  });
+});
@@ -33,7 +33,15 @@
     # Indicates that the library should be built with compatibility for musl
     # libc, so that it can run on Alpine Linux. This is only necessary if not
     # building on Alpine Linux
-    'grpc_alpine%': 'false'
+    'grpc_alpine%': 'false',
+    # Which TLS library to use, 'auto' or 'node'. 'auto' builds and statically
+    # links the bundled BoringSSL on Windows, and uses the OpenSSL symbols that
+    # Node exports elsewhere. 'node' uses Node's OpenSSL on Windows too.
+    # Electron exports neither OpenSSL symbols nor headers, so it always uses
+    # BoringSSL. BoringSSL is never linked into an addon for a Node binary that
+    # exports OpenSSL, because the dynamic linker would bind the addon's SSL_*
+    # and EVP_* calls to Node's OpenSSL instead.
+    'grpc_ssl%': 'auto'
   },
   'target_defaults': {
     'configurations': {
@@ -122,7 +130,7 @@
         ]
       }],
       # This is the condition for using boringssl
-      ['OS=="win" or runtime=="electron"', {
+      ['runtime=="electron" or (OS=="win" and grpc_ssl=="auto")', {
         "include_dirs": [
           "deps/grpc/third_party/boringssl/include"
         ],
@@ -217,7 +225,13 @@
     ]
   },
   'conditions': [
-    ['OS=="win" or runtime=="electron"', {
+    ['grpc_ssl!="auto" and grpc_ssl!="node"', {
+      'variables': {
+        # Stops the configure step for an unknown grpc_ssl value
+        'grpc_ssl_is_unknown': '<!(node -e "throw new Error(\'grpc_ssl must be auto or node\')")'
+      }
+    }],
+    ['runtime=="electron" or (OS=="win" and grpc_ssl=="auto")', {
       'targets': [
         {
           'target_name': 'boringssl',
@@ -500,7 +514,7 @@
         },
       ],
     }],
-    ['OS == "win" and runtime!="electron"', {
+    ['OS == "win" and runtime!="electron" and grpc_ssl=="auto"', {
       'targets': [
         {
           # IMPORTANT WINDOWS BUILD INFORMATION
@@ -981,7 +995,7 @@
         '-Wno-cast-function-type'
       ],
       "conditions": [
-        ['OS=="win" or runtime=="electron"', {
+        ['runtime=="electron" or (OS=="win" and grpc_ssl=="auto")', {
           'dependencies': [
             "boringssl",
           ]
@@ -39,9 +39,21 @@ using v8::Object;
 using v8::Number;
 using v8::Value;
 
+/* Messages up to this size are copied into a slice owned by core instead of
+   holding a reference to the JavaScript buffer until core is done with it.
+   The copy is cheaper than creating and destroying a persistent handle, and
+   the smallest messages fit in an inlined slice that needs no allocation. */
+static const size_t kMaxCopiedMessageSize = 256;
+
 grpc_byte_buffer *BufferToByteBuffer(Local<Value> buffer) {
   Nan::HandleScope scope;
-  grpc_slice slice = CreateSliceFromBuffer(buffer);
+  size_t length = ::node::Buffer::Length(buffer);
+  grpc_slice slice;
+  if (length <= kMaxCopiedMessageSize) {
+    slice = grpc_slice_from_copied_buffer(::node::Buffer::Data(buffer), length);
+  } else {
+    slice = CreateSliceFromBuffer(buffer);
+  }
   grpc_byte_buffer *byte_buffer(grpc_raw_byte_buffer_create(&slice, 1));
   grpc_slice_unref(slice);
   return byte_buffer;
@@ -16,11 +16,15 @@
  *
  */
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <node.h>
+#include <uv.h>
 
 #include "byte_buffer.h"
 #include "call.h"
@@ -32,8 +36,10 @@
 #include "grpc/support/alloc.h"
 #include "grpc/support/log.h"
 #include "grpc/support/time.h"
+#include "metadata.h"
 #include "slice.h"
 #include "timeval.h"
+#include "util.h"
 
 using std::unique_ptr;
 using std::shared_ptr;
@@ -69,6 +75,73 @@ using v8::Value;
 Callback *Call::constructor;
 Persistent<FunctionTemplate> Call::fun_tpl;
 
+namespace {
+
+bool async_hooks_enabled = true;
+
+/* Nan::Callback::Call without a resource makes the callback without an async
+   context, which is what callers get when async_hooks integration is off */
+void CallWithResource(Callback *callback, int argc, Local<Value> argv[],
+                      Nan::AsyncResource *async_resource) {
+  if (async_resource == NULL) {
+    callback->Call(argc, argv);
+  } else {
+    callback->Call(argc, argv, async_resource);
+  }
+}
+
+/* Calls a batch's callback with the results of the ops from begin to end,
+   keyed by op type name */
+void RunBatchCallback(Callback *callback, OpVec::iterator begin,
+                      OpVec::iterator end, const char *error_message,
+                      Nan::AsyncResource *async_resource) {
+  if (error_message == NULL) {
+    Local<Object> tag_obj = Nan::New<Object>();
+    for (OpVec::iterator it = begin; it != end; ++it) {
+      Op *op_ptr = it->get();
+      Nan::Set(tag_obj, op_ptr->GetOpType(), op_ptr->GetNodeValue());
+    }
+    Local<Value> argv[] = {Nan::Null(), tag_obj};
+    CallWithResource(callback, 2, argv, async_resource);
+  } else {
+    Local<Value> argv[] = {Nan::Error(error_message)};
+    CallWithResource(callback, 1, argv, async_resource);
+  }
+}
+
+bool ReceivesAnything(const vector<grpc_op> &ops) {
+  for (const grpc_op &op : ops) {
+    switch (op.op) {
+      case GRPC_OP_RECV_INITIAL_METADATA:
+      case GRPC_OP_RECV_MESSAGE:
+      case GRPC_OP_RECV_STATUS_ON_CLIENT:
+      case GRPC_OP_RECV_CLOSE_ON_SERVER:
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+// Calls with merged batches that have not been started yet
+vector<Call *> calls_with_merged_batches;
+uv_idle_t merged_batch_idle;
+
+/* An active idle handle also keeps the loop from blocking in its poll phase,
+   so this runs early in the next loop iteration wherever the batches were
+   merged */
+void StartMergedBatches(uv_idle_t *handle) {
+  Nan::HandleScope scope;
+  while (!calls_with_merged_batches.empty()) {
+    // This removes the call from the list
+    calls_with_merged_batches.back()->StartMergedBatch();
+  }
+  uv_idle_stop(handle);
+}
+
+}  // namespace
+
 /**
  * Helper function for throwing errors with a grpc_call_error value.
  * Modified from the answer by Gus Goose to
@@ -84,6 +157,12 @@ Local<Value> nanErrorWithCode(const char *msg, grpc_call_error code) {
 bool CreateMetadataArray(Local<Object> metadata_obj, grpc_metadata_array *array) {
   HandleScope scope;
   Local<Value> metadata_value = (Nan::Get(metadata_obj, Nan::New("metadata").ToLocalChecked())).ToLocalChecked();
+  if (Metadata::HasInstance(metadata_value)) {
+    // Metadata objects already hold validated entries
+    ObjectWrap::Unwrap<Metadata>(Nan::To<Object>(metadata_value)
+                                     .ToLocalChecked())->CopyToArray(array);
+    return true;
+  }
   if (!metadata_value->IsObject()) {
     return false;
   }
@@ -110,12 +189,12 @@ bool CreateMetadataArray(Local<Object> metadata_obj, grpc_metadata_array *array)
     for (unsigned int j = 0; j < values->Length(); j++) {
       Local<Value> value = Nan::Get(values, j).ToLocalChecked();
       grpc_metadata *current = &array->metadata[array->count];
-      current->key = key_intern_slice;
       // Only allow binary headers for "-bin" keys
       if (grpc_is_binary_header(key_intern_slice)) {
         if (::node::Buffer::HasInstance(value)) {
           current->value = CreateSliceFromBuffer(value);
         } else {
+          grpc_slice_unref(key_intern_slice);
           return false;
         }
       } else {
@@ -123,49 +202,67 @@ bool CreateMetadataArray(Local<Object> metadata_obj, grpc_metadata_array *array)
           Local<String> string_value = Nan::To<String>(value).ToLocalChecked();
           current->value = CreateSliceFromString(string_value);
         } else {
+          grpc_slice_unref(key_intern_slice);
           return false;
         }
       }
+      current->key = grpc_slice_ref(key_intern_slice);
       array->count += 1;
     }
+    grpc_slice_unref(key_intern_slice);
   }
   return true;
 }
 
 void DestroyMetadataArray(grpc_metadata_array *array) {
   for (size_t i = 0; i < array->count; i++) {
-    // Don't unref keys because they are interned
+    grpc_slice_unref(array->metadata[i].key);
     grpc_slice_unref(array->metadata[i].value);
   }
   grpc_metadata_array_destroy(array);
 }
 
-Local<Value> ParseMetadata(const grpc_metadata_array *metadata_array) {
-  EscapableHandleScope scope;
-  grpc_metadata *metadata_elements = metadata_array->metadata;
-  size_t length = metadata_array->count;
-  Local<Object> metadata_object = Nan::New<Object>();
-  for (unsigned int i = 0; i < length; i++) {
-    grpc_metadata *elem = &metadata_elements[i];
-    // TODO(murgatroid99): Use zero-copy string construction instead
-    Local<String> key_string = CopyStringFromSlice(elem->key);
-    Local<Array> array;
-    MaybeLocal<Value> maybe_array = Nan::Get(metadata_object, key_string);
-    if (maybe_array.IsEmpty() || !maybe_array.ToLocalChecked()->IsArray()) {
-      array = Nan::New<Array>(0);
-      Nan::Set(metadata_object, key_string, array);
-    } else {
-      array = Local<Array>::Cast(maybe_array.ToLocalChecked());
-    }
-    if (grpc_is_binary_header(elem->key)) {
-      Nan::Set(array, array->Length(), CreateBufferFromSlice(elem->value));
-    } else {
-      // TODO(murgatroid99): Use zero-copy string construction instead
-      Nan::Set(array, array->Length(), CopyStringFromSlice(elem->value));
+namespace {
+
+/* The data of the lazy metadata property holds the wrapped metadata and, once
+   it has been read or assigned, the property's value */
+const uint32_t kLazyMetadataWrapped = 0;
+const uint32_t kLazyMetadataValue = 1;
+
+NAN_GETTER(GetLazyMetadata) {
+  Local<Object> data = info.Data().As<Object>();
+  Local<Value> value = Nan::Get(data, kLazyMetadataValue).ToLocalChecked();
+  if (value->IsUndefined()) {
+    Local<Value> wrapped =
+        Nan::Get(data, kLazyMetadataWrapped).ToLocalChecked();
+    if (!Metadata::HasInstance(wrapped)) {
+      return;
     }
+    Metadata *metadata = ObjectWrap::Unwrap<Metadata>(wrapped.As<Object>());
+    value = metadata->ToPlainObject();
+    Nan::Set(data, kLazyMetadataValue, value);
   }
+  info.GetReturnValue().Set(value);
+}
+
+NAN_SETTER(SetLazyMetadata) {
+  Nan::Set(info.Data().As<Object>(), kLazyMetadataValue, value);
+}
+
+}  // namespace
+
+Local<Value> ParseMetadata(const grpc_metadata_array *metadata_array) {
+  EscapableHandleScope scope;
+  Local<Value> wrapped = Metadata::WrapArray(metadata_array);
   Local<Object> result = Nan::New<Object>();
-  Nan::Set(result, Nan::New("metadata").ToLocalChecked(), metadata_object);
+  Nan::Set(result, Nan::New("native_metadata").ToLocalChecked(), wrapped);
+  /* Most results are only passed to Metadata._fromCoreRepresentation, which
+     uses the wrapped entries, so the object that maps each key to an array of
+     its values is only created if something reads it */
+  Local<Object> data = Nan::New<Object>();
+  Nan::Set(data, kLazyMetadataWrapped, wrapped);
+  Nan::SetAccessor(result, Nan::New("metadata").ToLocalChecked(),
+                   GetLazyMetadata, SetLazyMetadata, data);
   Nan::Set(result, Nan::New("flags").ToLocalChecked(), Nan::New<v8::Uint32>(0));
   return scope.Escape(result);
 }
@@ -463,38 +560,97 @@ class ServerCloseResponseOp : public Op {
   int cancelled;
 };
 
+/* Receives the close status of a server call without calling into
+   javascript, unless the call was cancelled or the op failed */
+class ServerCancelWatchOp : public Op {
+ public:
+  ServerCancelWatchOp(Call *call, Callback *on_cancel)
+      : call(call), on_cancel(on_cancel), cancelled(0) {}
+  ~ServerCancelWatchOp() { delete on_cancel; }
+
+  Local<Value> GetNodeValue() const {
+    EscapableHandleScope scope;
+    return scope.Escape(Nan::New<Boolean>(cancelled));
+  }
+
+  bool ParseOp(Local<Value> value, grpc_op *out) {
+    out->data.recv_close_on_server.cancelled = &cancelled;
+    return true;
+  }
+  bool IsFinalOp() { return false; }
+  void OnComplete(bool success) {
+    HandleScope scope;
+    if (success) {
+      if (!cancelled) {
+        return;
+      }
+      call->MarkCancelled();
+    }
+    Local<Value> argv[] = {
+        success ? Local<Value>(Nan::Null())
+                : Nan::Error("Failed to receive the call's close status")};
+    CallWithResource(on_cancel, 1, argv, call->GetAsyncResource());
+  }
+
+ protected:
+  std::string GetTypeString() const { return "cancelled"; }
+
+ private:
+  Call *call;
+  Callback *on_cancel;
+  int cancelled;
+};
+
 tag::tag(Callback *callback, OpVec *ops, Call *call, Local<Value> call_value)
     : callback(callback),
       async_resource(NULL),
       ops(ops),
       call(call) {
   HandleScope scope;
-  async_resource = new Nan::AsyncResource("grpc:tag");  // Needs handle scope.
-  call_persist.Reset(call_value);
+  if (call == NULL) {
+    if (callback != NULL && async_hooks_enabled) {
+      // Needs handle scope.
+      async_resource = new Nan::AsyncResource("grpc:tag");
+    }
+    call_persist.Reset(call_value);
+  }
 }
 
 tag::~tag() {
   delete callback;
+  for (const BatchCallback &batch : merged_callbacks) {
+    delete batch.callback;
+  }
   delete async_resource;
   delete ops;
 }
 
+Nan::AsyncResource *tag::GetAsyncResource() {
+  if (call != NULL) {
+    return call->GetAsyncResource();
+  }
+  return async_resource;
+}
+
 void CompleteTag(void *tag, const char *error_message) {
   HandleScope scope;
   struct tag *tag_struct = reinterpret_cast<struct tag *>(tag);
   Callback *callback = tag_struct->callback;
-  if (error_message == NULL) {
-    Local<Object> tag_obj = Nan::New<Object>();
-    for (vector<unique_ptr<Op> >::iterator it = tag_struct->ops->begin();
-         it != tag_struct->ops->end(); ++it) {
-      Op *op_ptr = it->get();
-      Nan::Set(tag_obj, op_ptr->GetOpType(), op_ptr->GetNodeValue());
+  OpVec *ops = tag_struct->ops;
+  if (!tag_struct->merged_callbacks.empty()) {
+    // Each merged batch's callback only gets the results of its own ops
+    size_t begin = 0;
+    for (const BatchCallback &batch : tag_struct->merged_callbacks) {
+      RunBatchCallback(batch.callback, ops->begin() + begin,
+                       ops->begin() + batch.ops_end, error_message,
+                       tag_struct->GetAsyncResource());
+      begin = batch.ops_end;
     }
-    Local<Value> argv[] = {Nan::Null(), tag_obj};
-    callback->Call(2, argv, tag_struct->async_resource);
+  } else if (callback == NULL) {
+    // The ops report their own results in OnComplete
   } else {
-    Local<Value> argv[] = {Nan::Error(error_message)};
-    callback->Call(1, argv, tag_struct->async_resource);
+    RunBatchCallback(callback, ops->begin(), ops->end(), error_message,
+                     tag_struct->GetAsyncResource());
   }
   bool success = (error_message == NULL);
   bool is_final_op = false;
@@ -517,42 +673,126 @@ void DestroyTag(void *tag) {
   delete tag_struct;
 }
 
+void SetAsyncHooksEnabled(bool enabled) { async_hooks_enabled = enabled; }
+
 void Call::DestroyCall() {
+  Untrack();
   if (this->wrapped_call != NULL) {
-    grpc_call_unref(this->wrapped_call);
+    // getPeer is often called to log a call after it completes
+    this->completed_call = this->wrapped_call;
     this->wrapped_call = NULL;
   }
+  // No more batches can complete, so this emits the resource's destroy event
+  delete this->async_resource;
+  this->async_resource = NULL;
 }
 
-Call::Call(grpc_call *call)
-    : wrapped_call(call), pending_batches(0), has_final_op_completed(false) {
-  peer = grpc_call_get_peer(call);
+void Call::Untrack() {
+  if (live_list == NULL) {
+    return;
+  }
+  if (live_prev != NULL) {
+    live_prev->live_next = live_next;
+  } else {
+    live_list->head = live_next;
+  }
+  if (live_next != NULL) {
+    live_next->live_prev = live_prev;
+  }
+  live_list = NULL;
+  live_prev = NULL;
+  live_next = NULL;
+  grpc_slice_unref(method);
+  method = grpc_empty_slice();
 }
 
+struct MergedBatch {
+  MergedBatch() : op_vector(new OpVec()) {}
+  ~MergedBatch() {
+    for (const BatchCallback &batch : callbacks) {
+      delete batch.callback;
+    }
+  }
+
+  /* Core allows each type of op once per batch. Only batches that send are
+     merged, see StartBatch */
+  bool CanAdd(const vector<grpc_op> &batch_ops) const {
+    for (const grpc_op &batch_op : batch_ops) {
+      for (const grpc_op &op : ops) {
+        if (op.op == batch_op.op) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void Add(const vector<grpc_op> &batch_ops, OpVec *batch_op_vector,
+           Callback *callback) {
+    ops.insert(ops.end(), batch_ops.begin(), batch_ops.end());
+    for (unique_ptr<Op> &op : *batch_op_vector) {
+      op_vector->push_back(std::move(op));
+    }
+    callbacks.push_back({callback, op_vector->size()});
+  }
+
+  vector<grpc_op> ops;
+  unique_ptr<OpVec> op_vector;
+  vector<BatchCallback> callbacks;
+};
+
+Call::Call(grpc_call *call)
+    : wrapped_call(call),
+      pending_batches(0),
+      async_resource(NULL),
+      has_final_op_completed(false),
+      cancelled(false),
+      completed_call(NULL),
+      live_list(NULL),
+      live_prev(NULL),
+      live_next(NULL),
+      method(grpc_empty_slice()),
+      group(0),
+      merge_batches(false) {}
+
 Call::~Call() {
-  DestroyCall();
-  gpr_free(peer);
+  Untrack();
+  if (wrapped_call != NULL) {
+    grpc_call_unref(wrapped_call);
+  }
+  if (completed_call != NULL) {
+    grpc_call_unref(completed_call);
+  }
+  delete async_resource;
+  peer.Reset();
 }
 
 void Call::Init(Local<Object> exports) {
   HandleScope scope;
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("Call").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
   Nan::SetPrototypeMethod(tpl, "startBatch", StartBatch);
   Nan::SetPrototypeMethod(tpl, "cancel", Cancel);
   Nan::SetPrototypeMethod(tpl, "cancelWithStatus", CancelWithStatus);
   Nan::SetPrototypeMethod(tpl, "getPeer", GetPeer);
   Nan::SetPrototypeMethod(tpl, "setCredentials", SetCredentials);
+  Nan::SetPrototypeMethod(tpl, "watchCancel", WatchCancel);
+  Nan::SetPrototypeMethod(tpl, "isCancelled", IsCancelled);
+  Nan::SetPrototypeMethod(tpl, "setBatchMerging", SetBatchMerging);
+  Nan::SetPrototypeMethod(tpl, "flushBatches", FlushBatches);
   fun_tpl.Reset(tpl);
+  uv_idle_init(uv_default_loop(), &merged_batch_idle);
   Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
   Nan::Set(exports, Nan::New("Call").ToLocalChecked(), ctr);
+  Nan::Set(exports, Nan::New("fanOut").ToLocalChecked(),
+           Nan::GetFunction(Nan::New<FunctionTemplate>(FanOut))
+               .ToLocalChecked());
   constructor = new Callback(ctr);
 }
 
 bool Call::HasInstance(Local<Value> val) {
-  HandleScope scope;
-  return Nan::New(fun_tpl)->HasInstance(val);
+  return HasTypeTag(val, &fun_tpl);
 }
 
 grpc_call *Call::GetWrappedCall() { return this->wrapped_call; }
@@ -574,13 +814,81 @@ Local<Value> Call::WrapStruct(grpc_call *call) {
   }
 }
 
+Local<Value> Call::WrapTrackedStruct(grpc_call *call, CallList *list,
+                                     const grpc_slice &method,
+                                     uint32_t group) {
+  EscapableHandleScope scope;
+  Local<Value> call_value = WrapStruct(call);
+  if (call_value->IsNull()) {
+    return scope.Escape(call_value);
+  }
+  Call *call_obj =
+      ObjectWrap::Unwrap<Call>(Nan::To<Object>(call_value).ToLocalChecked());
+  call_obj->method = grpc_slice_ref(method);
+  call_obj->group = group;
+  call_obj->peer_cache = list->peer_cache;
+  call_obj->live_list = list;
+  call_obj->live_next = list->head;
+  if (list->head != NULL) {
+    list->head->live_prev = call_obj;
+  }
+  list->head = call_obj;
+  return scope.Escape(call_value);
+}
+
+void Call::MarkCancelled() { this->cancelled = true; }
+
+Nan::AsyncResource *Call::GetAsyncResource() { return this->async_resource; }
+
+void Call::StartMergedBatch() {
+  vector<Call *>::reverse_iterator it =
+      std::find(calls_with_merged_batches.rbegin(),
+                calls_with_merged_batches.rend(), this);
+  if (it != calls_with_merged_batches.rend()) {
+    calls_with_merged_batches.erase(std::next(it).base());
+  }
+  if (this->merged_batch == NULL) {
+    return;
+  }
+  unique_ptr<MergedBatch> batch(std::move(this->merged_batch));
+  struct tag *batch_tag =
+      new struct tag(NULL, batch->op_vector.release(), this, Local<Value>());
+  batch_tag->merged_callbacks.swap(batch->callbacks);
+  grpc_call_error error = GRPC_CALL_ERROR;
+  if (this->wrapped_call != NULL) {
+    error = grpc_call_start_batch(this->wrapped_call, batch->ops.data(),
+                                  batch->ops.size(), batch_tag, NULL);
+  }
+  if (error != GRPC_CALL_OK) {
+    /* The startBatch calls that merged these batches have returned, so the
+       error is reported the way a failed batch would be */
+    CompleteTag(batch_tag, "startBatch failed");
+    DestroyTag(batch_tag);
+    return;
+  }
+  CompletionQueueNext();
+}
+
+void Call::AddPendingBatch(Local<Value> call_value) {
+  if (this->pending_batches == 0) {
+    this->pending_self_ref.Reset(call_value);
+  }
+  if (this->async_resource == NULL && async_hooks_enabled) {
+    this->async_resource = new Nan::AsyncResource("grpc:call");
+  }
+  this->pending_batches++;
+}
+
 void Call::CompleteBatch(bool is_final_op) {
   if (is_final_op) {
     this->has_final_op_completed = true;
   }
   this->pending_batches--;
-  if (this->has_final_op_completed && this->pending_batches == 0) {
-    this->DestroyCall();
+  if (this->pending_batches == 0) {
+    this->pending_self_ref.Reset();
+    if (this->has_final_op_completed) {
+      this->DestroyCall();
+    }
   }
 }
 
@@ -604,6 +912,7 @@ NAN_METHOD(Call::New) {
     grpc_call *call_value = reinterpret_cast<grpc_call *>(ext->Value());
     call = new Call(call_value);
     call->Wrap(info.This());
+    SetTypeTag(info.This(), &fun_tpl);
     info.GetReturnValue().Set(info.This());
     return;
   } else {
@@ -684,16 +993,275 @@ NAN_METHOD(Call::StartBatch) {
     op_vector->push_back(std::move(op));
   }
   Callback *callback = new Callback(callback_func);
+  if (call->merge_batches) {
+    /* A batch that receives anything is never merged, because a send's
+       callback would then wait for something to arrive, and the peer may be
+       waiting for the next send before it replies. Nothing could join it, so
+       it is started now, after the batches made before it */
+    bool receives = ReceivesAnything(ops);
+    if (call->merged_batch != NULL &&
+        (receives || !call->merged_batch->CanAdd(ops))) {
+      call->StartMergedBatch();
+    }
+    if (!receives) {
+      if (call->merged_batch == NULL) {
+        call->merged_batch.reset(new MergedBatch());
+        call->AddPendingBatch(info.This());
+        calls_with_merged_batches.push_back(call);
+        uv_idle_start(&merged_batch_idle, StartMergedBatches);
+      }
+      call->merged_batch->Add(ops, op_vector.get(), callback);
+      return;
+    }
+  }
   grpc_call_error error = grpc_call_start_batch(
       call->wrapped_call, &ops[0], nops,
       new struct tag(callback, op_vector.release(), call, info.This()), NULL);
   if (error != GRPC_CALL_OK) {
     return Nan::ThrowError(nanErrorWithCode("startBatch failed", error));
   }
-  call->pending_batches++;
+  call->AddPendingBatch(info.This());
   CompletionQueueNext();
 }
 
+namespace {
+
+/* Shared by the children of one fanOut call. The callback is called once,
+   with every child's result, after the last child's batch completes */
+struct FanOutState {
+  FanOutState(Local<Function> callback_func, uint32_t count)
+      : callback(callback_func), remaining(count) {
+    results.Reset(Nan::New<Array>(count));
+  }
+  ~FanOutState() { results.Reset(); }
+  Callback callback;
+  Persistent<Array> results;
+  uint32_t remaining;
+};
+
+struct FanOutChild {
+  FanOutState *state;
+  uint32_t index;
+};
+
+void FanOutStoreResult(FanOutState *state, uint32_t index,
+                       Local<Value> result) {
+  Nan::Set(Nan::New(state->results), index, result);
+  state->remaining--;
+  if (state->remaining == 0) {
+    Local<Function> callback_func = state->callback.GetFunction();
+    Local<Value> argv[] = {Nan::Null(), Nan::New(state->results)};
+    delete state;
+    Nan::Call(callback_func, Nan::New<Object>(), 2, argv);
+  }
+}
+
+/* The batch callback of one child call. It receives the same arguments as a
+   startBatch callback */
+NAN_METHOD(FanOutChildComplete) {
+  FanOutChild *child =
+      reinterpret_cast<FanOutChild *>(info.Data().As<External>()->Value());
+  FanOutState *state = child->state;
+  uint32_t index = child->index;
+  delete child;
+  FanOutStoreResult(state, index, info[0]->IsNull() ? info[1] : info[0]);
+}
+
+/* Fills ops with a complete unary exchange for one fanOut request */
+bool ParseFanOutOps(Local<Object> request, OpVec *op_vector,
+                    vector<grpc_op> *ops) {
+  HandleScope scope;
+  Local<Value> buffer =
+      Nan::Get(request, Nan::New("buffer").ToLocalChecked()).ToLocalChecked();
+  Local<Value> metadata_value =
+      Nan::Get(request, Nan::New("metadata").ToLocalChecked())
+          .ToLocalChecked();
+  Local<Object> send_metadata = request;
+  if (metadata_value->IsUndefined() || metadata_value->IsNull()) {
+    send_metadata = Nan::New<Object>();
+    Nan::Set(send_metadata, Nan::New("metadata").ToLocalChecked(),
+             Nan::New<Object>());
+  }
+  const grpc_op_type types[] = {
+      GRPC_OP_SEND_INITIAL_METADATA, GRPC_OP_SEND_MESSAGE,
+      GRPC_OP_SEND_CLOSE_FROM_CLIENT, GRPC_OP_RECV_INITIAL_METADATA,
+      GRPC_OP_RECV_MESSAGE, GRPC_OP_RECV_STATUS_ON_CLIENT};
+  const size_t nops = sizeof(types) / sizeof(types[0]);
+  ops->resize(nops);
+  op_vector->push_back(unique_ptr<Op>(new SendMetadataOp()));
+  op_vector->push_back(unique_ptr<Op>(new SendMessageOp()));
+  op_vector->push_back(unique_ptr<Op>(new SendClientCloseOp()));
+  op_vector->push_back(unique_ptr<Op>(new GetMetadataOp()));
+  op_vector->push_back(unique_ptr<Op>(new ReadMessageOp()));
+  op_vector->push_back(unique_ptr<Op>(new ClientStatusOp()));
+  Local<Value> values[] = {send_metadata, buffer, Nan::True(), Nan::True(),
+                           Nan::True(), Nan::True()};
+  for (size_t i = 0; i < nops; i++) {
+    (*ops)[i].op = types[i];
+    (*ops)[i].flags = 0;
+    (*ops)[i].reserved = NULL;
+    if (!(*op_vector)[i]->ParseOp(values[i], &(*ops)[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+NAN_METHOD(Call::FanOut) {
+  /* Arguments:
+   * 0: parent Call, or null
+   * 1: Non-empty array of requests, each an object with channel, method and
+   *    buffer properties, and optionally metadata
+   * 2: options object with optional deadline, propagateFlags and group
+   *    properties
+   * 3: callback, called once with an array of the results of every request.
+   *    If no request could be started, it is called before fanOut returns
+   */
+  grpc_call *parent_call = NULL;
+  if (HasInstance(info[0])) {
+    parent_call = ObjectWrap::Unwrap<Call>(
+        Nan::To<Object>(info[0]).ToLocalChecked())->wrapped_call;
+    if (parent_call == NULL) {
+      // Children of a finished call could not get its deadline or cancellation
+      return Nan::ThrowError("Cannot fanOut from a call that has completed");
+    }
+  } else if (!(info[0]->IsUndefined() || info[0]->IsNull())) {
+    return Nan::ThrowTypeError(
+        "fanOut's first argument must be a call, if provided");
+  }
+  if (!info[1]->IsArray()) {
+    return Nan::ThrowTypeError("fanOut's second argument must be an array");
+  }
+  if (!info[2]->IsObject()) {
+    return Nan::ThrowTypeError("fanOut's third argument must be an object");
+  }
+  if (!info[3]->IsFunction()) {
+    return Nan::ThrowTypeError("fanOut's fourth argument must be a callback");
+  }
+  Local<Array> requests = info[1].As<Array>();
+  Local<Object> options = Nan::To<Object>(info[2]).ToLocalChecked();
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_REALTIME);
+  Local<Value> deadline_value =
+      Nan::Get(options, Nan::New("deadline").ToLocalChecked())
+          .ToLocalChecked();
+  if (deadline_value->IsNumber() || deadline_value->IsDate()) {
+    deadline = MillisecondsToTimespec(Nan::To<double>(deadline_value)
+                                          .FromJust());
+  } else if (!deadline_value->IsUndefined()) {
+    return Nan::ThrowTypeError("fanOut's deadline must be a date or a number");
+  }
+  uint32_t propagate_flags = GRPC_PROPAGATE_DEFAULTS;
+  Local<Value> flags_value =
+      Nan::Get(options, Nan::New("propagateFlags").ToLocalChecked())
+          .ToLocalChecked();
+  if (flags_value->IsUint32()) {
+    propagate_flags = Nan::To<uint32_t>(flags_value).FromJust();
+  } else if (!flags_value->IsUndefined()) {
+    return Nan::ThrowTypeError("fanOut's propagateFlags must be an integer");
+  }
+  uint32_t group = 0;
+  Local<Value> group_value =
+      Nan::Get(options, Nan::New("group").ToLocalChecked()).ToLocalChecked();
+  if (group_value->IsUint32()) {
+    group = Nan::To<uint32_t>(group_value).FromJust();
+  } else if (!group_value->IsUndefined()) {
+    return Nan::ThrowTypeError("fanOut's group must be an integer");
+  }
+  /* Every request is checked before any call is created, so that a bad
+     request does not leave the earlier ones running */
+  uint32_t count = requests->Length();
+  if (count == 0) {
+    /* The callback is called from the completion queue unless every child
+       fails to start, so an empty list is left to the caller, which reports
+       those results asynchronously */
+    return Nan::ThrowRangeError("fanOut needs at least one request");
+  }
+  vector<Channel *> channels(count);
+  vector<unique_ptr<OpVec>> op_vectors(count);
+  vector<vector<grpc_op>> ops(count);
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> request_value = Nan::Get(requests, i).ToLocalChecked();
+    if (!request_value->IsObject()) {
+      return Nan::ThrowTypeError("fanOut's requests must be objects");
+    }
+    Local<Object> request = Nan::To<Object>(request_value).ToLocalChecked();
+    Local<Value> channel_value =
+        Nan::Get(request, Nan::New("channel").ToLocalChecked())
+            .ToLocalChecked();
+    if (!Channel::HasInstance(channel_value)) {
+      return Nan::ThrowTypeError("fanOut request's channel must be a Channel");
+    }
+    channels[i] = ObjectWrap::Unwrap<Channel>(
+        Nan::To<Object>(channel_value).ToLocalChecked());
+    if (channels[i]->GetWrappedChannel() == NULL) {
+      return Nan::ThrowError("Cannot fanOut to a closed Channel");
+    }
+    if (!Nan::Get(request, Nan::New("method").ToLocalChecked())
+             .ToLocalChecked()->IsString()) {
+      return Nan::ThrowTypeError("fanOut request's method must be a string");
+    }
+    op_vectors[i].reset(new OpVec());
+    if (!ParseFanOutOps(request, op_vectors[i].get(), &ops[i])) {
+      return Nan::ThrowTypeError("Incorrectly typed fanOut request");
+    }
+  }
+  Local<Array> children = Nan::New<Array>(count);
+  FanOutState *state = new FanOutState(info[3].As<Function>(), count);
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Object> request =
+        Nan::To<Object>(Nan::Get(requests, i).ToLocalChecked())
+            .ToLocalChecked();
+    grpc_slice method = CreateSliceFromString(
+        Nan::To<String>(Nan::Get(request, Nan::New("method").ToLocalChecked())
+                            .ToLocalChecked()).ToLocalChecked());
+    grpc_call *wrapped_call = grpc_channel_create_call(
+        channels[i]->GetWrappedChannel(), parent_call, propagate_flags,
+        GetCompletionQueue(), method, NULL, deadline, NULL);
+    if (wrapped_call == NULL) {
+      grpc_slice_unref(method);
+      Nan::Set(children, i, Nan::Null());
+      FanOutStoreResult(state, i, Nan::Error("Failed to create call"));
+      continue;
+    }
+    Local<Value> child_value = WrapTrackedStruct(
+        wrapped_call, channels[i]->GetLiveCalls(), method, group);
+    grpc_slice_unref(method);
+    Nan::Set(children, i, child_value);
+    if (child_value->IsNull()) {
+      // The call was not wrapped, so it still belongs to this function
+      grpc_call_unref(wrapped_call);
+      FanOutStoreResult(state, i, Nan::Error("Failed to create call"));
+      continue;
+    }
+    Call *child = ObjectWrap::Unwrap<Call>(
+        Nan::To<Object>(child_value).ToLocalChecked());
+    FanOutChild *child_data = new FanOutChild();
+    child_data->state = state;
+    child_data->index = i;
+    Callback *callback = new Callback(Nan::New<Function>(
+        FanOutChildComplete, Nan::New<External>(child_data)));
+    struct tag *child_tag =
+        new struct tag(callback, op_vectors[i].release(), child, child_value);
+    grpc_call_error error = grpc_call_start_batch(
+        wrapped_call, &ops[i][0], ops[i].size(), child_tag, NULL);
+    if (error != GRPC_CALL_OK) {
+      // The tag will never complete, so the failure is reported directly
+      delete child_tag;
+      delete child_data;
+      child->DestroyCall();
+      FanOutStoreResult(state, i,
+                        nanErrorWithCode("startBatch failed", error));
+      continue;
+    }
+    child->AddPendingBatch(child_value);
+    // Each started batch completes, and is counted by the queue, separately
+    CompletionQueueNext();
+  }
+  info.GetReturnValue().Set(children);
+}
+
 NAN_METHOD(Call::Cancel) {
   if (!Call::HasInstance(info.This())) {
     return Nan::ThrowTypeError("cancel can only be called on Call objects");
@@ -745,8 +1313,26 @@ NAN_METHOD(Call::GetPeer) {
     return Nan::ThrowTypeError("getPeer can only be called on Call objects");
   }
   Call *call = ObjectWrap::Unwrap<Call>(info.This());
-  Local<Value> peer_value = Nan::New(call->peer).ToLocalChecked();
-  info.GetReturnValue().Set(peer_value);
+  if (call->peer.IsEmpty()) {
+    grpc_call *core_call = call->wrapped_call != NULL ? call->wrapped_call
+                                                      : call->completed_call;
+    if (core_call == NULL) {
+      return info.GetReturnValue().Set(Nan::New("unknown").ToLocalChecked());
+    }
+    char *peer = grpc_call_get_peer(core_call);
+    if (call->peer_cache) {
+      call->peer.Reset(call->peer_cache->GetPeerString(peer));
+    } else {
+      call->peer.Reset(Nan::New(peer).ToLocalChecked());
+    }
+    gpr_free(peer);
+  }
+  if (call->completed_call != NULL) {
+    // The peer was the only thing the completed call was kept for
+    grpc_call_unref(call->completed_call);
+    call->completed_call = NULL;
+  }
+  info.GetReturnValue().Set(Nan::New(call->peer));
 }
 
 NAN_METHOD(Call::SetCredentials) {
@@ -774,5 +1360,74 @@ NAN_METHOD(Call::SetCredentials) {
   info.GetReturnValue().Set(Nan::New<Uint32>(error));
 }
 
+NAN_METHOD(Call::WatchCancel) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "watchCancel can only be called on Call objects");
+  }
+  if (!info[0]->IsFunction()) {
+    return Nan::ThrowTypeError("watchCancel's argument must be a callback");
+  }
+  Call *call = ObjectWrap::Unwrap<Call>(info.This());
+  if (call->wrapped_call == NULL) {
+    return Nan::ThrowError(
+        "Cannot watch for cancellation on a call that has completed");
+  }
+  /* This is the same RECV_CLOSE_ON_SERVER op that startBatch can start, but
+     the batch completes natively, so a call that ends normally never calls
+     back into javascript */
+  grpc_op op;
+  op.op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op.flags = 0;
+  op.reserved = NULL;
+  unique_ptr<OpVec> ops(new OpVec());
+  ServerCancelWatchOp *watch_op =
+      new ServerCancelWatchOp(call, new Callback(info[0].As<Function>()));
+  ops->push_back(unique_ptr<Op>(watch_op));
+  watch_op->ParseOp(Nan::Undefined(), &op);
+  grpc_call_error error = grpc_call_start_batch(
+      call->wrapped_call, &op, 1,
+      new struct tag(NULL, ops.release(), call, info.This()), NULL);
+  if (error != GRPC_CALL_OK) {
+    return Nan::ThrowError(nanErrorWithCode("watchCancel failed", error));
+  }
+  call->AddPendingBatch(info.This());
+  CompletionQueueNext();
+}
+
+NAN_METHOD(Call::SetBatchMerging) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "setBatchMerging can only be called on Call objects");
+  }
+  if (!info[0]->IsBoolean()) {
+    return Nan::ThrowTypeError(
+        "setBatchMerging's argument must be a boolean");
+  }
+  Call *call = ObjectWrap::Unwrap<Call>(info.This());
+  call->merge_batches = Nan::To<bool>(info[0]).FromJust();
+  if (!call->merge_batches) {
+    call->StartMergedBatch();
+  }
+}
+
+NAN_METHOD(Call::FlushBatches) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "flushBatches can only be called on Call objects");
+  }
+  Call *call = ObjectWrap::Unwrap<Call>(info.This());
+  call->StartMergedBatch();
+}
+
+NAN_METHOD(Call::IsCancelled) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "isCancelled can only be called on Call objects");
+  }
+  Call *call = ObjectWrap::Unwrap<Call>(info.This());
+  info.GetReturnValue().Set(Nan::New<Boolean>(call->cancelled));
+}
+
 }  // namespace node
 }  // namespace grpc
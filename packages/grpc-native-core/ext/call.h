@@ -27,6 +27,7 @@
 #include "grpc/grpc.h"
 #include "grpc/support/log.h"
 
+#include "call_list.h"
 #include "channel.h"
 
 namespace grpc {
@@ -44,6 +45,14 @@ bool CreateMetadataArray(v8::Local<v8::Object> metadata,
 
 void DestroyMetadataArray(grpc_metadata_array *array);
 
+/* Sets whether batch callbacks run in async_hooks contexts. This is on by
+   default. When it is off, calls create no async resources, and their
+   callbacks run without an async context */
+void SetAsyncHooksEnabled(bool enabled);
+
+// Batches waiting to be started together, defined in call.cc
+struct MergedBatch;
+
 /* Wrapper class for grpc_call structs. */
 class Call : public Nan::ObjectWrap {
  public:
@@ -51,11 +60,28 @@ class Call : public Nan::ObjectWrap {
   static bool HasInstance(v8::Local<v8::Value> val);
   /* Wrap a grpc_call struct in a javascript object */
   static v8::Local<v8::Value> WrapStruct(grpc_call *call);
+  /* Wrap a grpc_call struct and add it to list. group 0 means no group */
+  static v8::Local<v8::Value> WrapTrackedStruct(grpc_call *call,
+                                                CallList *list,
+                                                const grpc_slice &method,
+                                                uint32_t group);
 
   grpc_call *GetWrappedCall();
 
   void CompleteBatch(bool is_final_op);
 
+  /* The async resource that this call's batch callbacks run in, or NULL if
+     async_hooks integration is disabled */
+  Nan::AsyncResource *GetAsyncResource();
+
+  /* Records that the call was cancelled, as reported by a
+     GRPC_OP_RECV_CLOSE_ON_SERVER op */
+  void MarkCancelled();
+
+  /* Starts the batches that startBatch has been merging, if there are any.
+     This happens automatically once per event loop iteration */
+  void StartMergedBatch();
+
  private:
   explicit Call(grpc_call *call);
   ~Call();
@@ -65,6 +91,10 @@ class Call : public Nan::ObjectWrap {
   Call &operator=(const Call &);
 
   void DestroyCall();
+  void Untrack();
+  /* Counts a batch that was just started. The call keeps itself alive while
+     it has pending batches */
+  void AddPendingBatch(v8::Local<v8::Value> call_value);
 
   static NAN_METHOD(New);
   static NAN_METHOD(StartBatch);
@@ -72,6 +102,11 @@ class Call : public Nan::ObjectWrap {
   static NAN_METHOD(CancelWithStatus);
   static NAN_METHOD(GetPeer);
   static NAN_METHOD(SetCredentials);
+  static NAN_METHOD(WatchCancel);
+  static NAN_METHOD(IsCancelled);
+  static NAN_METHOD(SetBatchMerging);
+  static NAN_METHOD(FlushBatches);
+  static NAN_METHOD(FanOut);
   static Nan::Callback *constructor;
   // Used for typechecking instances of this javascript class
   static Nan::Persistent<v8::FunctionTemplate> fun_tpl;
@@ -79,11 +114,38 @@ class Call : public Nan::ObjectWrap {
   grpc_call *wrapped_call;
   // The number of ops that were started but not completed on this call
   int pending_batches;
+  // Set while pending_batches is not 0
+  Nan::Persistent<v8::Value> pending_self_ref;
+  /* Created with the first batch, and shared by all of them, so every
+     batch's callback runs in the async context that started the first
+     batch, not in the one that started that batch */
+  Nan::AsyncResource *async_resource;
   /* Indicates whether the "final" op on a call has completed. For a client
      call, this is GRPC_OP_RECV_STATUS_ON_CLIENT and for a server call, this
      is GRPC_OP_SEND_STATUS_FROM_SERVER */
   bool has_final_op_completed;
-  char *peer;
+  // Set when a server call's close op reports that it was cancelled
+  bool cancelled;
+  // Fetched on the first call to getPeer
+  Nan::Persistent<v8::String> peer;
+  /* The core call after it has completed. It is only kept until getPeer is
+     called or the call is collected, so that the peer is only fetched if
+     something asks for it */
+  grpc_call *completed_call;
+  // The cache of the list the call was created in, if any
+  std::shared_ptr<PeerCache> peer_cache;
+  // The list this call is tracked in, if any, and its links in that list
+  CallList *live_list;
+  Call *live_prev;
+  Call *live_next;
+  grpc_slice method;
+  uint32_t group;
+  /* When set, startBatch adds its batch to merged_batch instead of starting
+     it, so that batches started close together reach core as one */
+  bool merge_batches;
+  unique_ptr<MergedBatch> merged_batch;
+
+  friend class CallList;
 };
 
 class Op {
@@ -100,11 +162,26 @@ class Op {
 };
 
 typedef std::vector<unique_ptr<Op>> OpVec;
+
+/* One of the batches that make up a merged batch. Its ops are the ones in the
+   tag's OpVec after the previous batch's ops_end, up to ops_end */
+struct BatchCallback {
+  Nan::Callback *callback;
+  size_t ops_end;
+};
+/* A batch's completion state. Batches on a Call use the call's async
+   resource and the call keeps itself alive, so the tag only has its own
+   resource and reference to call_value for batches that are not on a Call */
 struct tag {
   tag(Nan::Callback *callback, OpVec *ops, Call *call,
       v8::Local<v8::Value> call_value);
   ~tag();
+  Nan::AsyncResource *GetAsyncResource();
+  /* Called with the results of the ops when the batch completes. If this is
+     NULL, the ops' OnComplete methods handle the results themselves */
   Nan::Callback *callback;
+  // Used instead of callback for a merged batch
+  std::vector<BatchCallback> merged_callbacks;
   Nan::AsyncResource *async_resource;
   OpVec *ops;
   Call *call;
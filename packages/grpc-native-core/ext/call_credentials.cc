@@ -24,6 +24,8 @@
 
 #include "call.h"
 #include "call_credentials.h"
+#include "node_grpc.h"
+#include "util.h"
 #include "grpc/grpc.h"
 #include "grpc/grpc_security.h"
 #include "grpc/support/log.h"
@@ -66,7 +68,7 @@ void CallCredentials::Init(Local<Object> exports) {
   HandleScope scope;
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("CallCredentials").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
   Nan::SetPrototypeMethod(tpl, "compose", Compose);
   fun_tpl.Reset(tpl);
   Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
@@ -83,8 +85,7 @@ void CallCredentials::Init(Local<Object> exports) {
 }
 
 bool CallCredentials::HasInstance(Local<Value> val) {
-  HandleScope scope;
-  return Nan::New(fun_tpl)->HasInstance(val);
+  return HasTypeTag(val, &fun_tpl);
 }
 
 Local<Value> CallCredentials::WrapStruct(grpc_call_credentials *credentials) {
@@ -119,6 +120,7 @@ NAN_METHOD(CallCredentials::New) {
         reinterpret_cast<grpc_call_credentials *>(ext->Value());
     CallCredentials *credentials = new CallCredentials(creds_value);
     credentials->Wrap(info.This());
+    SetTypeTag(info.This(), &fun_tpl);
     info.GetReturnValue().Set(info.This());
     return;
   } else {
@@ -146,6 +148,7 @@ NAN_METHOD(CallCredentials::Compose) {
 }
 
 NAN_METHOD(CallCredentials::CreateFromPlugin) {
+  EnsureCoreInitialized();
   if (!info[0]->IsFunction()) {
     return Nan::ThrowTypeError(
         "createFromPlugin's argument must be a function");
@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include <string>
+
+#include <nan.h>
+#include <node.h>
+
+#include "call.h"
+#include "call_list.h"
+#include "grpc/grpc.h"
+
+namespace grpc {
+namespace node {
+
+using Nan::EscapableHandleScope;
+using Nan::Utf8String;
+
+using v8::Local;
+using v8::Number;
+using v8::String;
+
+PeerCache::PeerCache() : next(0) {}
+
+PeerCache::~PeerCache() {
+  for (size_t i = 0; i < kSize; i++) {
+    strings[i].Reset();
+  }
+}
+
+Local<String> PeerCache::GetPeerString(const char *peer) {
+  EscapableHandleScope scope;
+  for (size_t i = 0; i < kSize; i++) {
+    if (!strings[i].IsEmpty() && peers[i] == peer) {
+      return scope.Escape(Nan::New(strings[i]));
+    }
+  }
+  Local<String> peer_string = Nan::New(peer).ToLocalChecked();
+  peers[next] = peer;
+  strings[next].Reset(peer_string);
+  next = (next + 1) % kSize;
+  return scope.Escape(peer_string);
+}
+
+CallList::CallList() : head(NULL), peer_cache(new PeerCache()) {}
+
+CallList::~CallList() {
+  while (head != NULL) {
+    head->Untrack();
+  }
+}
+
+size_t CallList::CancelAll(grpc_status_code code, const char *details,
+                           const std::string &method_prefix, uint32_t group) {
+  size_t cancelled = 0;
+  for (Call *call = head; call != NULL; call = call->live_next) {
+    if (group != 0) {
+      if (call->group != group) {
+        continue;
+      }
+    } else if (GRPC_SLICE_LENGTH(call->method) < method_prefix.size() ||
+               memcmp(GRPC_SLICE_START_PTR(call->method),
+                      method_prefix.data(), method_prefix.size()) != 0) {
+      continue;
+    }
+    // Cancelling only queues completions, so the list does not change here
+    grpc_call_cancel_with_status(call->wrapped_call, code, details, NULL);
+    cancelled++;
+  }
+  return cancelled;
+}
+
+void CancelAllInList(CallList *list, NAN_METHOD_ARGS_TYPE info) {
+  if (!info[0]->IsUint32()) {
+    return Nan::ThrowTypeError(
+        "cancelAll's first argument must be a status code");
+  }
+  if (!info[1]->IsString()) {
+    return Nan::ThrowTypeError("cancelAll's second argument must be a string");
+  }
+  grpc_status_code code =
+      static_cast<grpc_status_code>(Nan::To<uint32_t>(info[0]).FromJust());
+  if (code == GRPC_STATUS_OK) {
+    return Nan::ThrowRangeError("cancelAll cannot be called with OK status");
+  }
+  std::string method_prefix;
+  uint32_t group = 0;
+  if (info[2]->IsString()) {
+    method_prefix = *Utf8String(info[2]);
+  } else if (info[2]->IsUint32() &&
+             Nan::To<uint32_t>(info[2]).FromJust() != 0) {
+    group = Nan::To<uint32_t>(info[2]).FromJust();
+  } else if (!(info[2]->IsUndefined() || info[2]->IsNull())) {
+    return Nan::ThrowTypeError(
+        "cancelAll's third argument must be a method prefix or a call group");
+  }
+  Utf8String details(info[1]);
+  size_t cancelled = list->CancelAll(code, *details, method_prefix, group);
+  info.GetReturnValue().Set(Nan::New<Number>(static_cast<double>(cancelled)));
+}
+
+}  // namespace node
+}  // namespace grpc
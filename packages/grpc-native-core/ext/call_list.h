@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NET_GRPC_NODE_CALL_LIST_H_
+#define NET_GRPC_NODE_CALL_LIST_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include <nan.h>
+#include <node.h>
+#include "grpc/grpc.h"
+
+namespace grpc {
+namespace node {
+
+class Call;
+
+/* The peer strings of the calls on one Channel or Server. Calls on the same
+   connection have the same peer, so the strings for the last few peers are
+   reused instead of creating one for each call. Calls share ownership of it,
+   because they can ask for their peer after the channel is gone. */
+class PeerCache {
+ public:
+  PeerCache();
+  ~PeerCache();
+
+  v8::Local<v8::String> GetPeerString(const char *peer);
+
+ private:
+  // Prevent copying
+  PeerCache(const PeerCache &);
+  PeerCache &operator=(const PeerCache &);
+
+  static const size_t kSize = 4;
+  std::string peers[kSize];
+  Nan::Persistent<v8::String> strings[kSize];
+  // The entry that the next new peer replaces
+  size_t next;
+};
+
+/* An intrusive list of the live calls on one Channel or Server, so that
+   they can be cancelled together without going through javascript. Calls
+   leave the list when they finish or are garbage collected. */
+class CallList {
+ public:
+  CallList();
+  ~CallList();
+
+  /* Cancels the live calls whose method starts with method_prefix, or, if
+     group is not 0, that were created in that group. Returns the number of
+     calls cancelled */
+  size_t CancelAll(grpc_status_code code, const char *details,
+                   const std::string &method_prefix, uint32_t group);
+
+ private:
+  // Prevent copying
+  CallList(const CallList &);
+  CallList &operator=(const CallList &);
+
+  Call *head;
+  std::shared_ptr<PeerCache> peer_cache;
+
+  friend class Call;
+};
+
+/* Implements cancelAll(code, details, filter) for a Channel or Server's
+   list. filter may be a method prefix string, a call group number, or
+   undefined to cancel every call */
+void CancelAllInList(CallList *list, NAN_METHOD_ARGS_TYPE info);
+
+}  // namespace node
+}  // namespace grpc
+
+#endif  // NET_GRPC_NODE_CALL_LIST_H_
@@ -26,10 +26,13 @@
 #include "channel.h"
 #include "channel_credentials.h"
 #include "completion_queue.h"
+#include "node_grpc.h"
+#include "resource_quota.h"
 #include "grpc/grpc.h"
 #include "grpc/grpc_security.h"
 #include "slice.h"
 #include "timeval.h"
+#include "util.h"
 
 namespace grpc {
 namespace node {
@@ -135,8 +138,20 @@ bool ParseChannelArgs(Local<Value> args_val,
         memcpy(channel_args->args[i].value.string, *val_str,
               val_str.length() + 1);
       }
+    } else if (ResourceQuota::HasInstance(value)) {
+      if (strcmp(*key_str, GRPC_ARG_RESOURCE_QUOTA) != 0) {
+        return false;
+      }
+      ResourceQuota *quota = ObjectWrap::Unwrap<ResourceQuota>(
+          Nan::To<Object>(value).ToLocalChecked());
+      /* The vtable refs the quota when core copies the args, so the args do
+         not need their own reference */
+      channel_args->args[i].type = GRPC_ARG_POINTER;
+      channel_args->args[i].value.pointer.p = quota->GetWrappedResourceQuota();
+      channel_args->args[i].value.pointer.vtable =
+          grpc_resource_quota_arg_vtable();
     } else {
-      // The value does not match either of the accepted types
+      // The value does not match any of the accepted types
       return false;
     }
     channel_args->args[i].key =
@@ -183,13 +198,14 @@ void Channel::Init(Local<Object> exports) {
   Nan::HandleScope scope;
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("Channel").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
   Nan::SetPrototypeMethod(tpl, "close", Close);
   Nan::SetPrototypeMethod(tpl, "getTarget", GetTarget);
   Nan::SetPrototypeMethod(tpl, "getConnectivityState", GetConnectivityState);
   Nan::SetPrototypeMethod(tpl, "watchConnectivityState",
                           WatchConnectivityState);
   Nan::SetPrototypeMethod(tpl, "createCall", CreateCall);
+  Nan::SetPrototypeMethod(tpl, "cancelAll", CancelAll);
   fun_tpl.Reset(tpl);
   Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
   Nan::Set(exports, Nan::New("Channel").ToLocalChecked(), ctr);
@@ -197,13 +213,15 @@ void Channel::Init(Local<Object> exports) {
 }
 
 bool Channel::HasInstance(Local<Value> val) {
-  HandleScope scope;
-  return Nan::New(fun_tpl)->HasInstance(val);
+  return HasTypeTag(val, &fun_tpl);
 }
 
 grpc_channel *Channel::GetWrappedChannel() { return this->wrapped_channel; }
 
+CallList *Channel::GetLiveCalls() { return &this->live_calls; }
+
 NAN_METHOD(Channel::New) {
+  EnsureCoreInitialized();
   if (info.IsConstructCall()) {
     if (!info[0]->IsString()) {
       return Nan::ThrowTypeError(
@@ -237,6 +255,7 @@ NAN_METHOD(Channel::New) {
     DeallocateChannelArgs(channel_args_ptr);
     Channel *channel = new Channel(wrapped_channel);
     channel->Wrap(info.This());
+    SetTypeTag(info.This(), &fun_tpl);
     info.GetReturnValue().Set(info.This());
     return;
   } else {
@@ -336,6 +355,7 @@ NAN_METHOD(Channel::CreateCall) {
    * 2: host
    * 3: parent Call
    * 4: propagation flags
+   * 5: call group, for cancelAll
    */
   if (!HasInstance(info.This())) {
     return Nan::ThrowTypeError(
@@ -365,6 +385,13 @@ NAN_METHOD(Channel::CreateCall) {
     return Nan::ThrowTypeError(
         "createCall's fifth argument must be propagate flags, if provided");
   }
+  uint32_t group = 0;
+  if (info[5]->IsUint32()) {
+    group = Nan::To<uint32_t>(info[5]).FromJust();
+  } else if (!(info[5]->IsUndefined() || info[5]->IsNull())) {
+    return Nan::ThrowTypeError(
+        "createCall's sixth argument must be a call group, if provided");
+  }
   Channel *channel = ObjectWrap::Unwrap<Channel>(info.This());
   grpc_channel *wrapped_channel = channel->GetWrappedChannel();
   if (wrapped_channel == NULL) {
@@ -389,8 +416,18 @@ NAN_METHOD(Channel::CreateCall) {
   } else {
     return Nan::ThrowTypeError("createCall's third argument must be a string");
   }
+  info.GetReturnValue().Set(Call::WrapTrackedStruct(
+      wrapped_call, &channel->live_calls, method, group));
   grpc_slice_unref(method);
-  info.GetReturnValue().Set(Call::WrapStruct(wrapped_call));
+}
+
+NAN_METHOD(Channel::CancelAll) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "cancelAll can only be called on Channel objects");
+  }
+  Channel *channel = ObjectWrap::Unwrap<Channel>(info.This());
+  CancelAllInList(&channel->live_calls, info);
 }
 
 }  // namespace node
@@ -21,6 +21,7 @@
 
 #include <nan.h>
 #include <node.h>
+#include "call_list.h"
 #include "grpc/grpc.h"
 
 namespace grpc {
@@ -43,6 +44,9 @@ class Channel : public Nan::ObjectWrap {
   /* Returns the grpc_channel struct that this object wraps */
   grpc_channel *GetWrappedChannel();
 
+  /* Returns the list of live calls created on this channel */
+  CallList *GetLiveCalls();
+
  private:
   explicit Channel(grpc_channel *channel);
   ~Channel();
@@ -57,10 +61,12 @@ class Channel : public Nan::ObjectWrap {
   static NAN_METHOD(GetConnectivityState);
   static NAN_METHOD(WatchConnectivityState);
   static NAN_METHOD(CreateCall);
+  static NAN_METHOD(CancelAll);
   static Nan::Callback *constructor;
   static Nan::Persistent<v8::FunctionTemplate> fun_tpl;
 
   grpc_channel *wrapped_channel;
+  CallList live_calls;
 };
 
 }  // namespace node
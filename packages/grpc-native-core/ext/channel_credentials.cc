@@ -21,6 +21,7 @@
 #include "call.h"
 #include "call_credentials.h"
 #include "channel_credentials.h"
+#include "node_grpc.h"
 #include "util.h"
 #include "grpc/grpc.h"
 #include "grpc/grpc_security.h"
@@ -102,7 +103,7 @@ void ChannelCredentials::Init(Local<Object> exports) {
   HandleScope scope;
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("ChannelCredentials").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
   Nan::SetPrototypeMethod(tpl, "compose", Compose);
   fun_tpl.Reset(tpl);
   Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
@@ -112,13 +113,15 @@ void ChannelCredentials::Init(Local<Object> exports) {
   Nan::Set(ctr, Nan::New("createInsecure").ToLocalChecked(),
            Nan::GetFunction(Nan::New<FunctionTemplate>(CreateInsecure))
                .ToLocalChecked());
+  Nan::Set(ctr, Nan::New("createLocal").ToLocalChecked(),
+           Nan::GetFunction(Nan::New<FunctionTemplate>(CreateLocal))
+               .ToLocalChecked());
   Nan::Set(exports, Nan::New("ChannelCredentials").ToLocalChecked(), ctr);
   constructor = new Nan::Callback(ctr);
 }
 
 bool ChannelCredentials::HasInstance(Local<Value> val) {
-  HandleScope scope;
-  return Nan::New(fun_tpl)->HasInstance(val);
+  return HasTypeTag(val, &fun_tpl);
 }
 
 Local<Value> ChannelCredentials::WrapStruct(
@@ -151,6 +154,7 @@ NAN_METHOD(ChannelCredentials::New) {
         reinterpret_cast<grpc_channel_credentials *>(ext->Value());
     ChannelCredentials *credentials = new ChannelCredentials(creds_value);
     credentials->Wrap(info.This());
+    SetTypeTag(info.This(), &fun_tpl);
     info.GetReturnValue().Set(info.This());
     return;
   } else {
@@ -161,6 +165,7 @@ NAN_METHOD(ChannelCredentials::New) {
 }
 
 NAN_METHOD(ChannelCredentials::CreateSsl) {
+  EnsureCoreInitialized();
   StringOrNull root_certs;
   StringOrNull private_key;
   StringOrNull cert_chain;
@@ -249,5 +254,12 @@ NAN_METHOD(ChannelCredentials::CreateInsecure) {
   info.GetReturnValue().Set(WrapStruct(NULL));
 }
 
+/* For connecting over a Unix domain socket to a server that uses local
+   server credentials */
+NAN_METHOD(ChannelCredentials::CreateLocal) {
+  EnsureCoreInitialized();
+  info.GetReturnValue().Set(WrapStruct(grpc_local_credentials_create(UDS)));
+}
+
 }  // namespace node
 }  // namespace grpc
@@ -49,6 +49,7 @@ class ChannelCredentials : public Nan::ObjectWrap {
   static NAN_METHOD(New);
   static NAN_METHOD(CreateSsl);
   static NAN_METHOD(CreateInsecure);
+  static NAN_METHOD(CreateLocal);
 
   static NAN_METHOD(Compose);
   static Nan::Callback *constructor;
@@ -27,6 +27,7 @@
 namespace grpc {
 namespace node {
 
+using v8::FunctionTemplate;
 using v8::Local;
 using v8::Object;
 using v8::Value;
@@ -35,6 +36,55 @@ grpc_completion_queue *queue;
 uv_prepare_t prepare;
 int pending_batches;
 
+/* Busy polling keeps an idle handle active while batches are pending. That
+   makes the loop poll for I/O with a timeout of 0 instead of sleeping, so it
+   sees network events without waiting for the kernel to wake it, at the cost
+   of a core spinning. The spinning is limited to busy_poll_budget of each
+   window; past that, the loop sleeps as usual until the next window */
+const uint64_t kBusyPollWindowNs = 100 * 1000 * 1000;
+uv_idle_t busy_poll_idle;
+// The fraction of each window that may be spent spinning. 0 disables it
+double busy_poll_budget;
+uint64_t busy_poll_window_start;
+uint64_t busy_poll_spent;
+// When the idle callback last ran, or 0 if the handle was just started
+uint64_t busy_poll_last;
+
+static bool busy_poll_window_elapsed(uint64_t now) {
+  if (now - busy_poll_window_start < kBusyPollWindowNs) {
+    return false;
+  }
+  busy_poll_window_start = now;
+  busy_poll_spent = 0;
+  return true;
+}
+
+static void busy_poll(uv_idle_t *handle) {
+  uint64_t now = uv_hrtime();
+  if (busy_poll_last != 0) {
+    // The loop did not sleep since the last iteration, so this was all spent
+    busy_poll_spent += now - busy_poll_last;
+  }
+  busy_poll_last = now;
+  if (!busy_poll_window_elapsed(now) &&
+      busy_poll_spent > busy_poll_budget * kBusyPollWindowNs) {
+    uv_idle_stop(handle);
+  }
+}
+
+static void start_busy_poll() {
+  if (busy_poll_budget == 0 ||
+      uv_is_active(reinterpret_cast<uv_handle_t *>(&busy_poll_idle))) {
+    return;
+  }
+  uint64_t now = uv_hrtime();
+  if (busy_poll_window_elapsed(now) ||
+      busy_poll_spent <= busy_poll_budget * kBusyPollWindowNs) {
+    busy_poll_last = 0;
+    uv_idle_start(&busy_poll_idle, busy_poll);
+  }
+}
+
 static void drain_completion_queue(uv_prepare_t *handle) {
   Nan::HandleScope scope;
   grpc_event event;
@@ -56,8 +106,13 @@ static void drain_completion_queue(uv_prepare_t *handle) {
     }
     if (pending_batches == 0) {
       uv_prepare_stop(&prepare);
+      uv_idle_stop(&busy_poll_idle);
     }
   } while (event.type != GRPC_QUEUE_TIMEOUT);
+  if (pending_batches != 0) {
+    // Resumes busy polling if it ran out of budget in an earlier window
+    start_busy_poll();
+  }
 }
 
 grpc_completion_queue *GetCompletionQueue() { return queue; }
@@ -65,14 +120,43 @@ grpc_completion_queue *GetCompletionQueue() { return queue; }
 void CompletionQueueNext() {
   if (pending_batches == 0) {
     uv_prepare_start(&prepare, drain_completion_queue);
+    start_busy_poll();
   }
   pending_batches++;
 }
 
+NAN_METHOD(SetBusyPolling) {
+  if (!info[0]->IsNumber()) {
+    return Nan::ThrowTypeError("setBusyPolling's argument must be a number");
+  }
+  double budget = Nan::To<double>(info[0]).FromJust();
+  if (!(budget >= 0 && budget <= 1)) {
+    return Nan::ThrowRangeError(
+        "setBusyPolling's argument must be between 0 and 1");
+  }
+  busy_poll_budget = budget;
+  if (budget == 0) {
+    uv_idle_stop(&busy_poll_idle);
+  } else if (pending_batches != 0) {
+    start_busy_poll();
+  }
+}
+
 void CompletionQueueInit(Local<Object> exports) {
-  queue = grpc_completion_queue_create_for_next(NULL);
+  queue = NULL;
   uv_prepare_init(uv_default_loop(), &prepare);
   pending_batches = 0;
+  uv_idle_init(uv_default_loop(), &busy_poll_idle);
+  busy_poll_budget = 0;
+  busy_poll_window_start = 0;
+  busy_poll_spent = 0;
+  Nan::Set(exports, Nan::New("setBusyPolling").ToLocalChecked(),
+           Nan::GetFunction(Nan::New<FunctionTemplate>(SetBusyPolling))
+               .ToLocalChecked());
+}
+
+void CompletionQueueCreate() {
+  queue = grpc_completion_queue_create_for_next(NULL);
 }
 
 void CompletionQueueForcePoll() {
@@ -80,7 +164,7 @@ void CompletionQueueForcePoll() {
    * Node polls for IO. But it doesn't increment the number of pending batches,
    * so it will immediately stop polling after that unless there is an
    * intervening CompletionQueueNext call */
-  if (pending_batches == 0) {
+  if (queue != NULL && pending_batches == 0) {
     uv_prepare_start(&prepare, drain_completion_queue);
   }
 }
@@ -28,6 +28,9 @@ void CompletionQueueNext();
 
 void CompletionQueueInit(v8::Local<v8::Object> exports);
 
+// Creates the queue. Needs core to be initialized
+void CompletionQueueCreate();
+
 void CompletionQueueForcePoll();
 
 }  // namespace node
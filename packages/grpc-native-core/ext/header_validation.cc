@@ -0,0 +1,141 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include <nan.h>
+#include <node.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GRPC_NODE_HEADER_VALIDATION_SSE2
+#endif
+
+#include "header_validation.h"
+
+namespace grpc {
+namespace node {
+
+using v8::Local;
+using v8::String;
+
+namespace {
+
+inline bool IsKeyChar(unsigned char c) {
+  return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' ||
+         c == '_' || c == '.';
+}
+
+inline bool IsNonbinValueChar(unsigned char c) {
+  return c >= 0x20 && c <= 0x7e;
+}
+
+#ifdef GRPC_NODE_HEADER_VALIDATION_SSE2
+/* Returns a mask with 0xff in each byte of chars that is in [low, high].
+   SSE2 only has signed byte comparisons, so the range is first shifted to
+   start at -128 */
+inline __m128i InRange(__m128i chars, unsigned char low, unsigned char high) {
+  __m128i shifted =
+      _mm_add_epi8(chars, _mm_set1_epi8(static_cast<char>(0x80 - low)));
+  return _mm_cmplt_epi8(
+      shifted, _mm_set1_epi8(static_cast<char>(0x80 + (high - low) + 1)));
+}
+
+inline __m128i Equals(__m128i chars, char c) {
+  return _mm_cmpeq_epi8(chars, _mm_set1_epi8(c));
+}
+#endif
+
+}  // namespace
+
+bool HeaderKeyIsLegal(const char *data, size_t length) {
+  if (length == 0) {
+    return false;
+  }
+  size_t i = 0;
+#ifdef GRPC_NODE_HEADER_VALIDATION_SSE2
+  for (; i + 16 <= length; i += 16) {
+    __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i legal = _mm_or_si128(
+        _mm_or_si128(InRange(chars, 'a', 'z'), InRange(chars, '0', '9')),
+        _mm_or_si128(Equals(chars, '-'),
+                     _mm_or_si128(Equals(chars, '_'), Equals(chars, '.'))));
+    if (_mm_movemask_epi8(legal) != 0xffff) {
+      return false;
+    }
+  }
+#endif
+  for (; i < length; i++) {
+    if (!IsKeyChar(static_cast<unsigned char>(data[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HeaderNonbinValueIsLegal(const char *data, size_t length) {
+  size_t i = 0;
+#ifdef GRPC_NODE_HEADER_VALIDATION_SSE2
+  for (; i + 16 <= length; i += 16) {
+    __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    if (_mm_movemask_epi8(InRange(chars, 0x20, 0x7e)) != 0xffff) {
+      return false;
+    }
+  }
+#endif
+  for (; i < length; i++) {
+    if (!IsNonbinValueChar(static_cast<unsigned char>(data[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HeaderKeyIsBinary(const char *data, size_t length) {
+  return length >= 4 && memcmp(data + length - 4, "-bin", 4) == 0;
+}
+
+OneByteContents::OneByteContents(Local<String> source)
+    : data(inline_buffer), length(source->Length()), one_byte(true) {
+  if (source->IsExternalOneByte()) {
+    data = source->GetExternalOneByteStringResource()->data();
+    return;
+  }
+  /* IsOneByte only checks the representation. Strings with only one-byte
+     characters can still be stored with two bytes per character, but they
+     are rare enough that scanning them first is fine */
+  if (!source->IsOneByte() && !source->ContainsOnlyOneByte()) {
+    one_byte = false;
+    return;
+  }
+  char *buffer = inline_buffer;
+  if (length > sizeof(inline_buffer)) {
+    heap_buffer.reset(new char[length]);
+    buffer = heap_buffer.get();
+  }
+  if (length > 0) {
+    Nan::DecodeWrite(buffer, length, source, Nan::BINARY);
+  }
+  data = buffer;
+}
+
+}  // namespace node
+}  // namespace grpc
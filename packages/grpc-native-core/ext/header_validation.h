@@ -0,0 +1,70 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NET_GRPC_NODE_HEADER_VALIDATION_H_
+#define NET_GRPC_NODE_HEADER_VALIDATION_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include <nan.h>
+#include <node.h>
+
+namespace grpc {
+namespace node {
+
+/* These checks accept exactly the same inputs as grpc_header_key_is_legal,
+   grpc_header_nonbin_value_is_legal and grpc_is_binary_header, but work on
+   raw bytes, so that they can run without building a slice. */
+
+bool HeaderKeyIsLegal(const char *data, size_t length);
+
+bool HeaderNonbinValueIsLegal(const char *data, size_t length);
+
+bool HeaderKeyIsBinary(const char *data, size_t length);
+
+/* The characters of a string as raw bytes, for the checks above. External
+   one-byte strings are read in place, and other strings are written to an
+   inline buffer, or to the heap only if they do not fit in it. IsOneByte()
+   is false if the string has characters that do not fit in one byte, because
+   those are never legal in metadata keys or non-binary values */
+class OneByteContents {
+ public:
+  explicit OneByteContents(v8::Local<v8::String> source);
+
+  bool IsOneByte() const { return one_byte; }
+  const char *Data() const { return data; }
+  size_t Length() const { return length; }
+
+ private:
+  // Prevent copying, since data can point into inline_buffer
+  OneByteContents(const OneByteContents &);
+  OneByteContents &operator=(const OneByteContents &);
+
+  char inline_buffer[128];
+  std::unique_ptr<char[]> heap_buffer;
+  const char *data;
+  size_t length;
+  bool one_byte;
+};
+
+}  // namespace node
+}  // namespace grpc
+
+#endif  // NET_GRPC_NODE_HEADER_VALIDATION_H_
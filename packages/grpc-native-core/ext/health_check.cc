@@ -0,0 +1,297 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include <nan.h>
+#include <node.h>
+
+#include "call.h"
+#include "completion_queue.h"
+#include "grpc/byte_buffer_reader.h"
+#include "grpc/grpc.h"
+#include "grpc/support/log.h"
+#include "health_check.h"
+
+namespace grpc {
+namespace node {
+
+using Nan::EscapableHandleScope;
+using Nan::HandleScope;
+
+using std::unique_ptr;
+using v8::Local;
+using v8::Value;
+
+namespace {
+
+const char kCheckMethod[] = "/grpc.health.v1.Health/Check";
+
+bool ReadVarint(const uint8_t **pos, const uint8_t *end, uint64_t *value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*pos == end) {
+      return false;
+    }
+    uint8_t byte = *(*pos)++;
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Reads the service field of a serialized HealthCheckRequest. Other fields
+   are skipped, as protobuf parsers do with unknown fields */
+bool ParseCheckRequest(grpc_byte_buffer *payload, std::string *service) {
+  grpc_byte_buffer_reader reader;
+  if (payload == NULL || !grpc_byte_buffer_reader_init(&reader, payload)) {
+    return false;
+  }
+  grpc_slice slice = grpc_byte_buffer_reader_readall(&reader);
+  grpc_byte_buffer_reader_destroy(&reader);
+  const uint8_t *pos = GRPC_SLICE_START_PTR(slice);
+  const uint8_t *end = GRPC_SLICE_END_PTR(slice);
+  bool ok = true;
+  service->clear();
+  while (ok && pos < end) {
+    uint64_t key;
+    uint64_t value;
+    if (!ReadVarint(&pos, end, &key)) {
+      ok = false;
+      break;
+    }
+    switch (key & 7) {
+      case 0:  // varint
+        ok = ReadVarint(&pos, end, &value);
+        break;
+      case 1:  // 64-bit
+        ok = end - pos >= 8;
+        pos += ok ? 8 : 0;
+        break;
+      case 2:  // length-delimited
+        ok = ReadVarint(&pos, end, &value) &&
+             value <= static_cast<uint64_t>(end - pos);
+        if (ok) {
+          if ((key >> 3) == 1) {
+            service->assign(reinterpret_cast<const char *>(pos), value);
+          }
+          pos += value;
+        }
+        break;
+      case 5:  // 32-bit
+        ok = end - pos >= 4;
+        pos += ok ? 4 : 0;
+        break;
+      default:
+        ok = false;
+    }
+  }
+  grpc_slice_unref(slice);
+  return ok;
+}
+
+/* Serializes a HealthCheckResponse with the given status */
+grpc_byte_buffer *CreateCheckResponse(uint32_t status) {
+  uint8_t bytes[6];
+  size_t length = 0;
+  // Fields with their default value, 0 for enums, are omitted
+  if (status != 0) {
+    bytes[length++] = 0x08;  // Field 1, varint
+    for (; status >= 0x80; status >>= 7) {
+      bytes[length++] = static_cast<uint8_t>(status | 0x80);
+    }
+    bytes[length++] = static_cast<uint8_t>(status);
+  }
+  grpc_slice slice =
+      grpc_slice_from_copied_buffer(reinterpret_cast<char *>(bytes), length);
+  grpc_byte_buffer *buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  return buffer;
+}
+
+class CheckRequestOp : public Op {
+ public:
+  CheckRequestOp(HealthCheckService *service, Local<Value> server_value)
+      : service(service), call(NULL), payload(NULL) {
+    grpc_metadata_array_init(&request_metadata);
+    server_ref.Reset(server_value);
+  }
+  ~CheckRequestOp() {
+    server_ref.Reset();
+    grpc_metadata_array_destroy(&request_metadata);
+    if (payload != NULL) {
+      grpc_byte_buffer_destroy(payload);
+    }
+  }
+
+  Local<Value> GetNodeValue() const {
+    EscapableHandleScope scope;
+    return scope.Escape(Nan::Undefined());
+  }
+  bool ParseOp(Local<Value> value, grpc_op *out) { return true; }
+  bool IsFinalOp() { return false; }
+  void OnComplete(bool success) {
+    HandleScope scope;
+    service->HandleCall(success, call, payload, Nan::New(server_ref));
+  }
+
+  // Valid while server_ref keeps the server that owns it alive
+  HealthCheckService *service;
+  Nan::Persistent<Value> server_ref;
+  grpc_call *call;
+  gpr_timespec deadline;
+  grpc_metadata_array request_metadata;
+  grpc_byte_buffer *payload;
+
+ protected:
+  std::string GetTypeString() const { return "health_check"; }
+};
+
+/* Owns the resources of a Check response until its batch completes */
+class CheckResponseOp : public Op {
+ public:
+  CheckResponseOp(grpc_call *call, grpc_byte_buffer *response)
+      : call(call), response(response), cancelled(0) {}
+  ~CheckResponseOp() {
+    if (response != NULL) {
+      grpc_byte_buffer_destroy(response);
+    }
+    grpc_call_unref(call);
+  }
+
+  Local<Value> GetNodeValue() const {
+    EscapableHandleScope scope;
+    return scope.Escape(Nan::Undefined());
+  }
+  bool ParseOp(Local<Value> value, grpc_op *out) { return true; }
+  bool IsFinalOp() { return false; }
+  void OnComplete(bool success) {}
+
+  grpc_call *call;
+  grpc_byte_buffer *response;
+  int cancelled;
+
+ protected:
+  std::string GetTypeString() const { return "health_check_response"; }
+};
+
+}  // namespace
+
+HealthCheckService::HealthCheckService(grpc_server *server)
+    : server(server) {
+  check_method =
+      grpc_server_register_method(server, kCheckMethod, NULL,
+                                  GRPC_SRM_PAYLOAD_READ_INITIAL_BYTE_BUFFER, 0);
+}
+
+void HealthCheckService::Start(Local<Value> server_value) {
+  RequestCall(server_value);
+}
+
+void HealthCheckService::SetStatus(const std::string &service,
+                                   uint32_t status) {
+  statuses[service] = status;
+}
+
+void HealthCheckService::RequestCall(Local<Value> server_value) {
+  /* Only one call is requested at a time. Check calls that arrive before
+     the next request wait in core's queue for the method */
+  CheckRequestOp *op = new CheckRequestOp(this, server_value);
+  unique_ptr<OpVec> ops(new OpVec());
+  ops->push_back(unique_ptr<Op>(op));
+  struct tag *request_tag = new struct tag(NULL, ops.release(), NULL,
+                                           Nan::Null());
+  grpc_call_error error = grpc_server_request_registered_call(
+      server, check_method, &op->call, &op->deadline, &op->request_metadata,
+      &op->payload, GetCompletionQueue(), GetCompletionQueue(), request_tag);
+  if (error != GRPC_CALL_OK) {
+    gpr_log(GPR_ERROR, "Requesting a health check call failed: %d", error);
+    delete request_tag;
+    return;
+  }
+  CompletionQueueNext();
+}
+
+void HealthCheckService::HandleCall(bool success, grpc_call *call,
+                                    grpc_byte_buffer *payload,
+                                    Local<Value> server_value) {
+  if (!success) {
+    return;
+  }
+  RequestCall(server_value);
+  std::string service;
+  grpc_status_code code = GRPC_STATUS_OK;
+  grpc_byte_buffer *response = NULL;
+  if (!ParseCheckRequest(payload, &service)) {
+    code = GRPC_STATUS_INTERNAL;
+  } else {
+    std::unordered_map<std::string, uint32_t>::const_iterator it =
+        statuses.find(service);
+    if (it == statuses.end()) {
+      code = GRPC_STATUS_NOT_FOUND;
+    } else {
+      response = CreateCheckResponse(it->second);
+    }
+  }
+  CheckResponseOp *op = new CheckResponseOp(call, response);
+  grpc_op ops[4];
+  size_t nops = 0;
+  ops[nops].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[nops].data.send_initial_metadata.count = 0;
+  ops[nops].data.send_initial_metadata.metadata = NULL;
+  nops++;
+  if (response != NULL) {
+    ops[nops].op = GRPC_OP_SEND_MESSAGE;
+    ops[nops].data.send_message.send_message = response;
+    nops++;
+  }
+  ops[nops].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[nops].data.send_status_from_server.trailing_metadata_count = 0;
+  ops[nops].data.send_status_from_server.trailing_metadata = NULL;
+  ops[nops].data.send_status_from_server.status = code;
+  ops[nops].data.send_status_from_server.status_details = NULL;
+  nops++;
+  ops[nops].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  ops[nops].data.recv_close_on_server.cancelled = &op->cancelled;
+  nops++;
+  for (size_t i = 0; i < nops; i++) {
+    ops[i].flags = 0;
+    ops[i].reserved = NULL;
+  }
+  unique_ptr<OpVec> op_vector(new OpVec());
+  op_vector->push_back(unique_ptr<Op>(op));
+  struct tag *response_tag =
+      new struct tag(NULL, op_vector.release(), NULL, Nan::Null());
+  grpc_call_error error =
+      grpc_call_start_batch(call, ops, nops, response_tag, NULL);
+  if (error != GRPC_CALL_OK) {
+    gpr_log(GPR_ERROR, "Responding to a health check call failed: %d", error);
+    // This also releases the call
+    delete response_tag;
+    return;
+  }
+  CompletionQueueNext();
+}
+
+}  // namespace node
+}  // namespace grpc
@@ -0,0 +1,71 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NET_GRPC_NODE_HEALTH_CHECK_H_
+#define NET_GRPC_NODE_HEALTH_CHECK_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+
+#include <nan.h>
+#include "grpc/grpc.h"
+
+namespace grpc {
+namespace node {
+
+/* Answers grpc.health.v1.Health/Check calls on a server without calling
+   into javascript. Javascript sets each service's status in advance, and
+   the calls are answered from that map as they complete on the queue */
+class HealthCheckService {
+ public:
+  /* Registers the Check method, so this must be constructed before the
+     server is started */
+  explicit HealthCheckService(grpc_server *server);
+
+  /* Starts waiting for Check calls. Call this after the server has started.
+     server_value is the javascript object of the server that owns this
+     service. Each pending request keeps it alive, so that the service
+     outlives the requests that refer to it */
+  void Start(v8::Local<v8::Value> server_value);
+
+  /* status is a grpc.health.v1.HealthCheckResponse.ServingStatus value */
+  void SetStatus(const std::string &service, uint32_t status);
+
+  /* Responds to call, which sent payload, and waits for the next call. Takes
+     ownership of call. If success is false, the server is shutting down */
+  void HandleCall(bool success, grpc_call *call, grpc_byte_buffer *payload,
+                  v8::Local<v8::Value> server_value);
+
+ private:
+  // Prevent copying
+  HealthCheckService(const HealthCheckService &);
+  HealthCheckService &operator=(const HealthCheckService &);
+
+  void RequestCall(v8::Local<v8::Value> server_value);
+
+  grpc_server *server;
+  void *check_method;
+  std::unordered_map<std::string, uint32_t> statuses;
+};
+
+}  // namespace node
+}  // namespace grpc
+
+#endif  // NET_GRPC_NODE_HEALTH_CHECK_H_
@@ -0,0 +1,387 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <nan.h>
+#include <node.h>
+
+#include "grpc/grpc.h"
+#include "grpc/slice.h"
+#include "grpc/support/alloc.h"
+#include "grpc/support/log.h"
+#include "header_validation.h"
+#include "metadata.h"
+#include "node_grpc.h"
+#include "slice.h"
+#include "util.h"
+
+namespace grpc {
+namespace node {
+
+using Nan::Callback;
+using Nan::EscapableHandleScope;
+using Nan::HandleScope;
+using Nan::MaybeLocal;
+using Nan::ObjectWrap;
+using Nan::Persistent;
+using Nan::Utf8String;
+
+using v8::Array;
+using v8::Function;
+using v8::FunctionTemplate;
+using v8::Local;
+using v8::Object;
+using v8::String;
+using v8::Value;
+
+Callback *Metadata::constructor;
+Persistent<FunctionTemplate> Metadata::fun_tpl;
+
+namespace {
+
+void ToLowerAscii(std::string *str) {
+  for (size_t i = 0; i < str->size(); i++) {
+    if ((*str)[i] >= 'A' && (*str)[i] <= 'Z') {
+      (*str)[i] += 'a' - 'A';
+    }
+  }
+}
+
+void ThrowIllegalKey(Local<Value> value) {
+  Utf8String utf8_key(value);
+  std::string key_string(*utf8_key, utf8_key.length());
+  ToLowerAscii(&key_string);
+  std::string message =
+      "Metadata key\"" + key_string + "\" contains illegal characters";
+  Nan::ThrowError(message.c_str());
+}
+
+/* Creates an interned slice from a metadata key, normalized to lowercase.
+   Throws a JavaScript error and returns false if the key is not legal */
+bool ParseKey(Local<Value> value, grpc_slice *key) {
+  if (!value->IsString()) {
+    Nan::ThrowTypeError("Metadata key must be a string");
+    return false;
+  }
+  OneByteContents contents(value.As<String>());
+  if (!contents.IsOneByte()) {
+    ThrowIllegalKey(value);
+    return false;
+  }
+  const char *data = contents.Data();
+  size_t length = contents.Length();
+  // Most keys are already lowercase, so they are checked without a copy
+  std::string lower_key;
+  for (size_t i = 0; i < length; i++) {
+    if (data[i] >= 'A' && data[i] <= 'Z') {
+      lower_key.assign(data, length);
+      ToLowerAscii(&lower_key);
+      data = lower_key.data();
+      break;
+    }
+  }
+  if (!HeaderKeyIsLegal(data, length)) {
+    ThrowIllegalKey(value);
+    return false;
+  }
+  // Interning copies the key, so it can be read from the temporary buffer
+  *key = grpc_slice_intern(grpc_slice_from_static_buffer(data, length));
+  return true;
+}
+
+/* Creates a slice holding a copy of a metadata value. Throws a JavaScript
+   error and returns false if the value is not legal for the key */
+bool ParseValue(grpc_slice key, Local<Value> value, grpc_slice *out) {
+  if (grpc_is_binary_header(key)) {
+    if (!::node::Buffer::HasInstance(value)) {
+      Nan::ThrowError("keys that end with '-bin' must have Buffer values");
+      return false;
+    }
+    *out = grpc_slice_from_copied_buffer(::node::Buffer::Data(value),
+                                         ::node::Buffer::Length(value));
+    return true;
+  }
+  if (!value->IsString()) {
+    Nan::ThrowError("keys that don't end with '-bin' must have String values");
+    return false;
+  }
+  OneByteContents contents(value.As<String>());
+  if (!contents.IsOneByte() ||
+      !HeaderNonbinValueIsLegal(contents.Data(), contents.Length())) {
+    Utf8String utf8_value(value);
+    std::string message = "Metadata string value \"" +
+                          std::string(*utf8_value, utf8_value.length()) +
+                          "\" contains illegal characters";
+    Nan::ThrowError(message.c_str());
+    return false;
+  }
+  // Legal values are ASCII, so the one-byte contents are also valid UTF-8
+  *out = grpc_slice_from_copied_buffer(contents.Data(), contents.Length());
+  return true;
+}
+
+Local<Value> ValueFromEntry(const grpc_metadata &entry) {
+  EscapableHandleScope scope;
+  if (grpc_is_binary_header(entry.key)) {
+    return scope.Escape(CreateBufferFromSlice(entry.value));
+  } else {
+    return scope.Escape(CopyStringFromSlice(entry.value));
+  }
+}
+
+}  // namespace
+
+Metadata::Metadata() {}
+
+Metadata::~Metadata() {
+  for (size_t i = 0; i < entries.size(); i++) {
+    grpc_slice_unref(entries[i].key);
+    grpc_slice_unref(entries[i].value);
+  }
+}
+
+void Metadata::Init(Local<Object> exports) {
+  HandleScope scope;
+  Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
+  tpl->SetClassName(Nan::New("Metadata").ToLocalChecked());
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
+  Nan::SetPrototypeMethod(tpl, "set", Set);
+  Nan::SetPrototypeMethod(tpl, "add", Add);
+  Nan::SetPrototypeMethod(tpl, "remove", Remove);
+  Nan::SetPrototypeMethod(tpl, "get", Get);
+  Nan::SetPrototypeMethod(tpl, "getMap", GetMap);
+  Nan::SetPrototypeMethod(tpl, "clone", Clone);
+  fun_tpl.Reset(tpl);
+  Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
+  Nan::Set(exports, Nan::New("Metadata").ToLocalChecked(), ctr);
+  constructor = new Callback(ctr);
+}
+
+bool Metadata::HasInstance(Local<Value> val) {
+  return HasTypeTag(val, &fun_tpl);
+}
+
+Local<Value> Metadata::WrapArray(const grpc_metadata_array *array) {
+  EscapableHandleScope scope;
+  MaybeLocal<Object> maybe_instance =
+      Nan::NewInstance(constructor->GetFunction(), 0, NULL);
+  if (maybe_instance.IsEmpty()) {
+    return scope.Escape(Nan::Null());
+  }
+  Local<Object> instance = maybe_instance.ToLocalChecked();
+  Metadata *metadata = ObjectWrap::Unwrap<Metadata>(instance);
+  metadata->entries.reserve(array->count);
+  for (size_t i = 0; i < array->count; i++) {
+    // The peer's values are passed through as they are, as they were when
+    // received metadata was a plain object
+    metadata->AddEntry(grpc_slice_intern(array->metadata[i].key),
+                       grpc_slice_ref(array->metadata[i].value));
+  }
+  return scope.Escape(instance);
+}
+
+void Metadata::CopyToArray(grpc_metadata_array *array) const {
+  GPR_ASSERT(array->count == 0);
+  if (entries.empty()) {
+    return;
+  }
+  gpr_free(array->metadata);
+  array->capacity = entries.size();
+  array->metadata = reinterpret_cast<grpc_metadata *>(
+      gpr_zalloc(array->capacity * sizeof(grpc_metadata)));
+  for (size_t i = 0; i < entries.size(); i++) {
+    array->metadata[i].key = grpc_slice_ref(entries[i].key);
+    array->metadata[i].value = grpc_slice_ref(entries[i].value);
+  }
+  array->count = entries.size();
+}
+
+Local<Object> Metadata::ToPlainObject() const {
+  EscapableHandleScope scope;
+  Local<Object> result = Nan::New<Object>();
+  for (size_t i = 0; i < entries.size(); i++) {
+    const grpc_metadata &entry = entries[i];
+    Local<String> key = CopyStringFromSlice(entry.key);
+    Local<Array> values;
+    MaybeLocal<Value> maybe_values = Nan::Get(result, key);
+    if (maybe_values.IsEmpty() || !maybe_values.ToLocalChecked()->IsArray()) {
+      values = Nan::New<Array>(0);
+      Nan::Set(result, key, values);
+    } else {
+      values = Local<Array>::Cast(maybe_values.ToLocalChecked());
+    }
+    Nan::Set(values, values->Length(), ValueFromEntry(entry));
+  }
+  return scope.Escape(result);
+}
+
+void Metadata::AddEntry(grpc_slice key, grpc_slice value) {
+  grpc_metadata entry;
+  memset(&entry, 0, sizeof(entry));
+  entry.key = key;
+  entry.value = value;
+  entries.push_back(entry);
+}
+
+void Metadata::RemoveEntries(grpc_slice key) {
+  std::vector<grpc_metadata>::iterator kept = entries.begin();
+  for (std::vector<grpc_metadata>::iterator it = entries.begin();
+       it != entries.end(); ++it) {
+    if (grpc_slice_eq(it->key, key)) {
+      grpc_slice_unref(it->key);
+      grpc_slice_unref(it->value);
+    } else {
+      *kept++ = *it;
+    }
+  }
+  entries.erase(kept, entries.end());
+}
+
+NAN_METHOD(Metadata::New) {
+  EnsureCoreInitialized();
+  if (info.IsConstructCall()) {
+    Metadata *metadata = new Metadata();
+    metadata->Wrap(info.This());
+    SetTypeTag(info.This(), &fun_tpl);
+    info.GetReturnValue().Set(info.This());
+  } else {
+    MaybeLocal<Object> maybe_instance =
+        Nan::NewInstance(constructor->GetFunction(), 0, NULL);
+    if (maybe_instance.IsEmpty()) {
+      // There's probably a pending exception
+      return;
+    } else {
+      info.GetReturnValue().Set(maybe_instance.ToLocalChecked());
+    }
+  }
+}
+
+NAN_METHOD(Metadata::Set) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError("set can only be called on Metadata objects");
+  }
+  Metadata *metadata = ObjectWrap::Unwrap<Metadata>(info.This());
+  grpc_slice key;
+  if (!ParseKey(info[0], &key)) {
+    return;
+  }
+  grpc_slice value;
+  if (!ParseValue(key, info[1], &value)) {
+    grpc_slice_unref(key);
+    return;
+  }
+  metadata->RemoveEntries(key);
+  metadata->AddEntry(key, value);
+}
+
+NAN_METHOD(Metadata::Add) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError("add can only be called on Metadata objects");
+  }
+  Metadata *metadata = ObjectWrap::Unwrap<Metadata>(info.This());
+  grpc_slice key;
+  if (!ParseKey(info[0], &key)) {
+    return;
+  }
+  grpc_slice value;
+  if (!ParseValue(key, info[1], &value)) {
+    grpc_slice_unref(key);
+    return;
+  }
+  metadata->AddEntry(key, value);
+}
+
+NAN_METHOD(Metadata::Remove) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "remove can only be called on Metadata objects");
+  }
+  Metadata *metadata = ObjectWrap::Unwrap<Metadata>(info.This());
+  grpc_slice key;
+  if (!ParseKey(info[0], &key)) {
+    return;
+  }
+  metadata->RemoveEntries(key);
+  grpc_slice_unref(key);
+}
+
+NAN_METHOD(Metadata::Get) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError("get can only be called on Metadata objects");
+  }
+  Metadata *metadata = ObjectWrap::Unwrap<Metadata>(info.This());
+  grpc_slice key;
+  if (!ParseKey(info[0], &key)) {
+    return;
+  }
+  Local<Array> values = Nan::New<Array>(0);
+  uint32_t length = 0;
+  for (size_t i = 0; i < metadata->entries.size(); i++) {
+    const grpc_metadata &entry = metadata->entries[i];
+    if (grpc_slice_eq(entry.key, key)) {
+      Nan::Set(values, length++, ValueFromEntry(entry));
+    }
+  }
+  grpc_slice_unref(key);
+  info.GetReturnValue().Set(values);
+}
+
+NAN_METHOD(Metadata::GetMap) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "getMap can only be called on Metadata objects");
+  }
+  Metadata *metadata = ObjectWrap::Unwrap<Metadata>(info.This());
+  Local<Object> result = Nan::New<Object>();
+  for (size_t i = 0; i < metadata->entries.size(); i++) {
+    const grpc_metadata &entry = metadata->entries[i];
+    Local<String> key = CopyStringFromSlice(entry.key);
+    // Only the first value for each key is included
+    if (!Nan::HasOwnProperty(result, key).FromMaybe(false)) {
+      Nan::Set(result, key, ValueFromEntry(entry));
+    }
+  }
+  info.GetReturnValue().Set(result);
+}
+
+NAN_METHOD(Metadata::Clone) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError("clone can only be called on Metadata objects");
+  }
+  Metadata *metadata = ObjectWrap::Unwrap<Metadata>(info.This());
+  MaybeLocal<Object> maybe_instance =
+      Nan::NewInstance(constructor->GetFunction(), 0, NULL);
+  if (maybe_instance.IsEmpty()) {
+    // There's probably a pending exception
+    return;
+  }
+  Local<Object> instance = maybe_instance.ToLocalChecked();
+  Metadata *copy = ObjectWrap::Unwrap<Metadata>(instance);
+  copy->entries.reserve(metadata->entries.size());
+  for (size_t i = 0; i < metadata->entries.size(); i++) {
+    copy->AddEntry(grpc_slice_ref(metadata->entries[i].key),
+                   grpc_slice_ref(metadata->entries[i].value));
+  }
+  info.GetReturnValue().Set(instance);
+}
+
+}  // namespace node
+}  // namespace grpc
@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NET_GRPC_NODE_METADATA_H_
+#define NET_GRPC_NODE_METADATA_H_
+
+#include <vector>
+
+#include <nan.h>
+#include <node.h>
+#include "grpc/grpc.h"
+
+namespace grpc {
+namespace node {
+
+/* Wrapper class for a list of grpc_metadata entries. Keys are interned and
+ * normalized to lowercase, and each entry holds a reference to its key and
+ * value slices, so the entries can be passed to core without conversion. */
+class Metadata : public Nan::ObjectWrap {
+ public:
+  static void Init(v8::Local<v8::Object> exports);
+  static bool HasInstance(v8::Local<v8::Value> val);
+  /* Wrap the entries of a metadata array received from core in a new
+     javascript object, without validating them. The array keeps ownership of
+     its own references */
+  static v8::Local<v8::Value> WrapArray(const grpc_metadata_array *array);
+
+  /* Fill array, which must be empty, with new references to each entry */
+  void CopyToArray(grpc_metadata_array *array) const;
+  /* Create an object that maps each key to an array of its values */
+  v8::Local<v8::Object> ToPlainObject() const;
+
+ private:
+  Metadata();
+  ~Metadata();
+
+  // Prevent copying
+  Metadata(const Metadata &);
+  Metadata &operator=(const Metadata &);
+
+  /* Takes ownership of the key and value references */
+  void AddEntry(grpc_slice key, grpc_slice value);
+  void RemoveEntries(grpc_slice key);
+
+  static NAN_METHOD(New);
+  static NAN_METHOD(Set);
+  static NAN_METHOD(Add);
+  static NAN_METHOD(Remove);
+  static NAN_METHOD(Get);
+  static NAN_METHOD(GetMap);
+  static NAN_METHOD(Clone);
+  static Nan::Callback *constructor;
+  // Used for typechecking instances of this javascript class
+  static Nan::Persistent<v8::FunctionTemplate> fun_tpl;
+
+  std::vector<grpc_metadata> entries;
+};
+
+}  // namespace node
+}  // namespace grpc
+
+#endif  // NET_GRPC_NODE_METADATA_H_
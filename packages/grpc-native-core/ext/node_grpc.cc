@@ -35,12 +35,19 @@
 #include "channel.h"
 #include "channel_credentials.h"
 #include "completion_queue.h"
+#include "header_validation.h"
+#include "metadata.h"
+#include "node_grpc.h"
+#include "resource_quota.h"
 #include "server.h"
 #include "server_credentials.h"
 #include "slice.h"
 #include "timeval.h"
 
-using grpc::node::CreateSliceFromString;
+using grpc::node::HeaderKeyIsBinary;
+using grpc::node::HeaderKeyIsLegal;
+using grpc::node::HeaderNonbinValueIsLegal;
+using grpc::node::OneByteContents;
 
 using v8::FunctionTemplate;
 using v8::Local;
@@ -127,10 +134,9 @@ NAN_METHOD(MetadataKeyIsLegal) {
   if (!info[0]->IsString()) {
     return Nan::ThrowTypeError("headerKeyIsLegal's argument must be a string");
   }
-  Local<String> key = Nan::To<String>(info[0]).ToLocalChecked();
-  grpc_slice slice = CreateSliceFromString(key);
-  info.GetReturnValue().Set(static_cast<bool>(grpc_header_key_is_legal(slice)));
-  grpc_slice_unref(slice);
+  OneByteContents key(info[0].As<String>());
+  info.GetReturnValue().Set(key.IsOneByte() &&
+                            HeaderKeyIsLegal(key.Data(), key.Length()));
 }
 
 NAN_METHOD(MetadataNonbinValueIsLegal) {
@@ -138,11 +144,10 @@ NAN_METHOD(MetadataNonbinValueIsLegal) {
     return Nan::ThrowTypeError(
         "metadataNonbinValueIsLegal's argument must be a string");
   }
-  Local<String> value = Nan::To<String>(info[0]).ToLocalChecked();
-  grpc_slice slice = CreateSliceFromString(value);
+  OneByteContents value(info[0].As<String>());
   info.GetReturnValue().Set(
-      static_cast<bool>(grpc_header_nonbin_value_is_legal(slice)));
-  grpc_slice_unref(slice);
+      value.IsOneByte() &&
+      HeaderNonbinValueIsLegal(value.Data(), value.Length()));
 }
 
 NAN_METHOD(MetadataKeyIsBinary) {
@@ -150,10 +155,13 @@ NAN_METHOD(MetadataKeyIsBinary) {
     return Nan::ThrowTypeError(
         "metadataKeyIsLegal's argument must be a string");
   }
-  Local<String> key = Nan::To<String>(info[0]).ToLocalChecked();
-  grpc_slice slice = CreateSliceFromString(key);
-  info.GetReturnValue().Set(static_cast<bool>(grpc_is_binary_header(slice)));
-  grpc_slice_unref(slice);
+  OneByteContents key(info[0].As<String>());
+  if (!key.IsOneByte()) {
+    Nan::Utf8String utf8_key(info[0]);
+    return info.GetReturnValue().Set(
+        HeaderKeyIsBinary(*utf8_key, utf8_key.length()));
+  }
+  info.GetReturnValue().Set(HeaderKeyIsBinary(key.Data(), key.Length()));
 }
 
 static grpc_ssl_roots_override_result get_ssl_roots_override(
@@ -227,6 +235,11 @@ void node_log_func(gpr_log_func_args *args) {
 }
 
 void init_logger() {
+  static bool logger_initialized = false;
+  if (logger_initialized) {
+    return;
+  }
+  logger_initialized = true;
   memset(&grpc_logger_state, 0, sizeof(logger_state));
   grpc_logger_state.pending_args = new std::queue<log_args *>();
   uv_mutex_init(&grpc_logger_state.mutex);
@@ -248,6 +261,7 @@ NAN_METHOD(SetDefaultLoggerCallback) {
     return Nan::ThrowTypeError(
         "setDefaultLoggerCallback's argument must be a function");
   }
+  init_logger();
   if (!grpc_logger_state.logger_set) {
     gpr_set_log_function(node_log_func);
     grpc_logger_state.logger_set = true;
@@ -265,25 +279,55 @@ NAN_METHOD(SetLogVerbosity) {
   gpr_set_log_verbosity(severity);
 }
 
+NAN_METHOD(SetAsyncHooksEnabled) {
+  if (!info[0]->IsBoolean()) {
+    return Nan::ThrowTypeError(
+        "setAsyncHooksEnabled's argument must be a boolean");
+  }
+  grpc::node::SetAsyncHooksEnabled(Nan::To<bool>(info[0]).FromJust());
+}
+
 NAN_METHOD(ForcePoll) {
   grpc::node::CompletionQueueForcePoll();
 }
 
-void init(Local<Object> exports) {
-  Nan::HandleScope scope;
+namespace grpc {
+namespace node {
+
+void EnsureCoreInitialized() {
+  static bool core_initialized = false;
+  if (core_initialized) {
+    return;
+  }
+  core_initialized = true;
   grpc_init();
   grpc_set_ssl_roots_override_callback(get_ssl_roots_override);
   init_logger();
+  CompletionQueueCreate();
+}
+
+}  // namespace node
+}  // namespace grpc
+
+void init(Local<Object> exports) {
+  Nan::HandleScope scope;
 
   InitOpTypeConstants(exports);
   InitConnectivityStateConstants(exports);
 
+  /* Core is built with GRPC_UV, so its TCP endpoints, timers and pollset
+     kicks are already libuv handles on Node's default loop, and network
+     readiness is handled in that loop's own poll. This stops the uv pollset
+     from running the loop itself when core polls. Completions are collected
+     once per loop iteration by the uv_prepare handle in completion_queue.cc */
   grpc_pollset_work_run_loop = 0;
 
   grpc::node::Call::Init(exports);
   grpc::node::CallCredentials::Init(exports);
   grpc::node::Channel::Init(exports);
   grpc::node::ChannelCredentials::Init(exports);
+  grpc::node::Metadata::Init(exports);
+  grpc::node::ResourceQuota::Init(exports);
   grpc::node::Server::Init(exports);
   grpc::node::ServerCredentials::Init(exports);
 
@@ -310,6 +354,9 @@ void init(Local<Object> exports) {
   Nan::Set(exports, Nan::New("setLogVerbosity").ToLocalChecked(),
            Nan::GetFunction(Nan::New<FunctionTemplate>(SetLogVerbosity))
                .ToLocalChecked());
+  Nan::Set(exports, Nan::New("setAsyncHooksEnabled").ToLocalChecked(),
+           Nan::GetFunction(Nan::New<FunctionTemplate>(SetAsyncHooksEnabled))
+               .ToLocalChecked());
   Nan::Set(exports, Nan::New("forcePoll").ToLocalChecked(),
            Nan::GetFunction(Nan::New<FunctionTemplate>(ForcePoll))
                .ToLocalChecked());
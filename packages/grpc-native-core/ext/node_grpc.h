@@ -0,0 +1,35 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NET_GRPC_NODE_NODE_GRPC_H_
+#define NET_GRPC_NODE_NODE_GRPC_H_
+
+namespace grpc {
+namespace node {
+
+/* Initializes gRPC core, the completion queue and the core logger if that has
+   not happened yet. Loading the module does not do this, so that processes
+   that load it without making any RPCs do not pay for it. Anything that calls
+   into core, other than through an object that already did that, must call
+   this first */
+void EnsureCoreInitialized();
+
+}  // namespace node
+}  // namespace grpc
+
+#endif  // NET_GRPC_NODE_NODE_GRPC_H_
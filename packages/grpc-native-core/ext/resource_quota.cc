@@ -0,0 +1,159 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <nan.h>
+#include <node.h>
+
+#include "grpc/grpc.h"
+#include "node_grpc.h"
+#include "resource_quota.h"
+#include "util.h"
+
+// TODO: Remove this when core has a public way to read a quota's usage
+#include "src/core/lib/iomgr/resource_quota.h"
+
+namespace grpc {
+namespace node {
+
+using Nan::ObjectWrap;
+using Nan::Persistent;
+using Nan::Utf8String;
+
+using v8::Function;
+using v8::FunctionTemplate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::Value;
+
+Persistent<FunctionTemplate> ResourceQuota::fun_tpl;
+
+namespace {
+
+// Sizes are numbers in JS, so they are limited to what a double holds exactly
+const double kMaxSafeInteger = 9007199254740991;
+
+bool ParseSize(Local<Value> value, size_t *out) {
+  if (!value->IsNumber()) {
+    return false;
+  }
+  double size = Nan::To<double>(value).FromJust();
+  if (!(size >= 0 && size <= kMaxSafeInteger) ||
+      size > static_cast<double>(static_cast<size_t>(-1))) {
+    return false;
+  }
+  *out = static_cast<size_t>(size);
+  return true;
+}
+
+}  // namespace
+
+ResourceQuota::ResourceQuota(grpc_resource_quota *quota, size_t size)
+    : wrapped_quota(quota), size(size) {}
+
+ResourceQuota::~ResourceQuota() { grpc_resource_quota_unref(wrapped_quota); }
+
+void ResourceQuota::Init(Local<Object> exports) {
+  Nan::HandleScope scope;
+  Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
+  tpl->SetClassName(Nan::New("ResourceQuota").ToLocalChecked());
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
+  Nan::SetPrototypeMethod(tpl, "resize", Resize);
+  Nan::SetPrototypeMethod(tpl, "getUsage", GetUsage);
+  fun_tpl.Reset(tpl);
+  Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
+  Nan::Set(exports, Nan::New("ResourceQuota").ToLocalChecked(), ctr);
+}
+
+bool ResourceQuota::HasInstance(Local<Value> val) {
+  return HasTypeTag(val, &fun_tpl);
+}
+
+grpc_resource_quota *ResourceQuota::GetWrappedResourceQuota() {
+  return wrapped_quota;
+}
+
+NAN_METHOD(ResourceQuota::New) {
+  if (!info.IsConstructCall()) {
+    return Nan::ThrowTypeError(
+        "ResourceQuota must be called with the new keyword");
+  }
+  size_t size;
+  if (!ParseSize(info[0], &size)) {
+    return Nan::ThrowTypeError(
+        "ResourceQuota's first argument must be a non-negative integer");
+  }
+  if (!info[1]->IsUndefined() && !info[1]->IsString()) {
+    return Nan::ThrowTypeError(
+        "ResourceQuota's second argument must be a string if provided");
+  }
+  EnsureCoreInitialized();
+  grpc_resource_quota *quota;
+  if (info[1]->IsString()) {
+    Utf8String name(info[1]);
+    quota = grpc_resource_quota_create(*name);
+  } else {
+    quota = grpc_resource_quota_create(NULL);
+  }
+  grpc_resource_quota_resize(quota, size);
+  ResourceQuota *resource_quota = new ResourceQuota(quota, size);
+  resource_quota->Wrap(info.This());
+  SetTypeTag(info.This(), &fun_tpl);
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(ResourceQuota::Resize) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "resize can only be called on ResourceQuota objects");
+  }
+  size_t size;
+  if (!ParseSize(info[0], &size)) {
+    return Nan::ThrowTypeError(
+        "resize's argument must be a non-negative integer");
+  }
+  ResourceQuota *resource_quota =
+      ObjectWrap::Unwrap<ResourceQuota>(info.This());
+  grpc_resource_quota_resize(resource_quota->wrapped_quota, size);
+  resource_quota->size = size;
+}
+
+/* Core only keeps an estimate of the fraction of the quota in use, which it
+   updates as it allocates and reclaims memory, so the usage is approximate */
+NAN_METHOD(ResourceQuota::GetUsage) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "getUsage can only be called on ResourceQuota objects");
+  }
+  ResourceQuota *resource_quota =
+      ObjectWrap::Unwrap<ResourceQuota>(info.This());
+  double pressure =
+      grpc_resource_quota_get_memory_pressure(resource_quota->wrapped_quota);
+  size_t used = static_cast<size_t>(resource_quota->size * pressure);
+  Local<Object> usage = Nan::New<Object>();
+  Nan::Set(usage, Nan::New("size").ToLocalChecked(),
+           Nan::New<Number>(static_cast<double>(resource_quota->size)));
+  Nan::Set(usage, Nan::New("used").ToLocalChecked(),
+           Nan::New<Number>(static_cast<double>(used)));
+  Nan::Set(usage, Nan::New("pressure").ToLocalChecked(),
+           Nan::New<Number>(pressure));
+  info.GetReturnValue().Set(usage);
+}
+
+}  // namespace node
+}  // namespace grpc
@@ -0,0 +1,65 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NET_GRPC_NODE_RESOURCE_QUOTA_H_
+#define NET_GRPC_NODE_RESOURCE_QUOTA_H_
+
+#include <stddef.h>
+
+#include <nan.h>
+#include <node.h>
+#include "grpc/grpc.h"
+
+namespace grpc {
+namespace node {
+
+/* Wrapper class for grpc_resource_quota structs. Passing one as the
+   "grpc.resource_quota" channel arg of channels and servers makes them share
+   its memory limit */
+class ResourceQuota : public Nan::ObjectWrap {
+ public:
+  static void Init(v8::Local<v8::Object> exports);
+  static bool HasInstance(v8::Local<v8::Value> val);
+
+  /* Returns the grpc_resource_quota struct that this object wraps. The
+     object keeps a reference to it */
+  grpc_resource_quota *GetWrappedResourceQuota();
+
+ private:
+  ResourceQuota(grpc_resource_quota *quota, size_t size);
+  ~ResourceQuota();
+
+  // Prevent copying
+  ResourceQuota(const ResourceQuota &);
+  ResourceQuota &operator=(const ResourceQuota &);
+
+  static NAN_METHOD(New);
+  static NAN_METHOD(Resize);
+  static NAN_METHOD(GetUsage);
+  // Used for typechecking instances of this javascript class
+  static Nan::Persistent<v8::FunctionTemplate> fun_tpl;
+
+  grpc_resource_quota *wrapped_quota;
+  // Core does not report the size, so it is kept here for getUsage
+  size_t size;
+};
+
+}  // namespace node
+}  // namespace grpc
+
+#endif  // NET_GRPC_NODE_RESOURCE_QUOTA_H_
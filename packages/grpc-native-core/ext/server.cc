@@ -26,12 +26,14 @@
 #include <vector>
 #include "call.h"
 #include "completion_queue.h"
+#include "node_grpc.h"
 #include "grpc/grpc.h"
 #include "grpc/grpc_security.h"
 #include "grpc/support/log.h"
 #include "server_credentials.h"
 #include "slice.h"
 #include "timeval.h"
+#include "util.h"
 
 namespace grpc {
 namespace node {
@@ -91,7 +93,7 @@ class ServerShutdownOp : public Op {
 
 class NewCallOp : public Op {
  public:
-  NewCallOp() {
+  NewCallOp(Server *server) : server(server) {
     call = NULL;
     grpc_call_details_init(&details);
     grpc_metadata_array_init(&request_metadata);
@@ -108,7 +110,9 @@ class NewCallOp : public Op {
       return scope.Escape(Nan::Null());
     }
     Local<Object> obj = Nan::New<Object>();
-    Nan::Set(obj, Nan::New("call").ToLocalChecked(), Call::WrapStruct(call));
+    Nan::Set(obj, Nan::New("call").ToLocalChecked(),
+             Call::WrapTrackedStruct(call, server->GetLiveCalls(),
+                                     details.method, 0));
     // TODO(murgatroid99): Use zero-copy string construction instead
     Nan::Set(obj, Nan::New("method").ToLocalChecked(),
              CopyStringFromSlice(details.method));
@@ -126,6 +130,7 @@ class NewCallOp : public Op {
   bool IsFinalOp() { return false; }
   void OnComplete(bool success) {}
 
+  Server *server;
   grpc_call *call;
   grpc_call_details details;
   grpc_metadata_array request_metadata;
@@ -150,12 +155,15 @@ void Server::Init(Local<Object> exports) {
   HandleScope scope;
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("Server").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
   Nan::SetPrototypeMethod(tpl, "requestCall", RequestCall);
   Nan::SetPrototypeMethod(tpl, "addHttp2Port", AddHttp2Port);
   Nan::SetPrototypeMethod(tpl, "start", Start);
   Nan::SetPrototypeMethod(tpl, "tryShutdown", TryShutdown);
   Nan::SetPrototypeMethod(tpl, "forceShutdown", ForceShutdown);
+  Nan::SetPrototypeMethod(tpl, "cancelAll", CancelAll);
+  Nan::SetPrototypeMethod(tpl, "enableHealthCheck", EnableHealthCheck);
+  Nan::SetPrototypeMethod(tpl, "setHealthStatus", SetHealthStatus);
   fun_tpl.Reset(tpl);
   Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
   Nan::Set(exports, Nan::New("Server").ToLocalChecked(), ctr);
@@ -166,10 +174,11 @@ void Server::Init(Local<Object> exports) {
 }
 
 bool Server::HasInstance(Local<Value> val) {
-  HandleScope scope;
-  return Nan::New(fun_tpl)->HasInstance(val);
+  return HasTypeTag(val, &fun_tpl);
 }
 
+CallList *Server::GetLiveCalls() { return &live_calls; }
+
 void Server::FinishShutdown() {
   is_shutdown = true;
   running_self_ref.Reset();
@@ -193,6 +202,7 @@ void Server::ShutdownServer() {
 }
 
 NAN_METHOD(Server::New) {
+  EnsureCoreInitialized();
   /* If this is not a constructor call, make a constructor call and return
      the result */
   if (!info.IsConstructCall()) {
@@ -222,6 +232,7 @@ NAN_METHOD(Server::New) {
   grpc_server_register_completion_queue(wrapped_server, queue, NULL);
   Server *server = new Server(wrapped_server);
   server->Wrap(info.This());
+  SetTypeTag(info.This(), &fun_tpl);
   info.GetReturnValue().Set(info.This());
 }
 
@@ -230,14 +241,15 @@ NAN_METHOD(Server::RequestCall) {
     return Nan::ThrowTypeError("requestCall can only be called on a Server");
   }
   Server *server = ObjectWrap::Unwrap<Server>(info.This());
-  NewCallOp *op = new NewCallOp();
+  NewCallOp *op = new NewCallOp(server);
   unique_ptr<OpVec> ops(new OpVec());
   ops->push_back(unique_ptr<Op>(op));
   grpc_call_error error = grpc_server_request_call(
       server->wrapped_server, &op->call, &op->details, &op->request_metadata,
       GetCompletionQueue(), GetCompletionQueue(),
+      // The server is kept alive until the new call is tracked in its list
       new struct tag(new Callback(info[0].As<Function>()), ops.release(), NULL,
-                     Nan::Null()));
+                     info.This()));
   if (error != GRPC_CALL_OK) {
     return Nan::ThrowError(nanErrorWithCode("requestCall failed", error));
   }
@@ -279,6 +291,9 @@ NAN_METHOD(Server::Start) {
   Server *server = ObjectWrap::Unwrap<Server>(info.This());
   server->running_self_ref.Reset(info.This());
   grpc_server_start(server->wrapped_server);
+  if (server->health_check) {
+    server->health_check->Start(info.This());
+  }
 }
 
 NAN_METHOD(Server::TryShutdown) {
@@ -309,5 +324,51 @@ NAN_METHOD(Server::ForceShutdown) {
   server->ShutdownServer();
 }
 
+NAN_METHOD(Server::CancelAll) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError("cancelAll can only be called on a Server");
+  }
+  Server *server = ObjectWrap::Unwrap<Server>(info.This());
+  CancelAllInList(&server->live_calls, info);
+}
+
+NAN_METHOD(Server::EnableHealthCheck) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "enableHealthCheck can only be called on a Server");
+  }
+  Server *server = ObjectWrap::Unwrap<Server>(info.This());
+  if (!server->running_self_ref.IsEmpty() || server->is_shutdown) {
+    return Nan::ThrowError(
+        "enableHealthCheck must be called before the server starts");
+  }
+  if (!server->health_check) {
+    server->health_check.reset(
+        new HealthCheckService(server->wrapped_server));
+  }
+}
+
+NAN_METHOD(Server::SetHealthStatus) {
+  if (!HasInstance(info.This())) {
+    return Nan::ThrowTypeError(
+        "setHealthStatus can only be called on a Server");
+  }
+  if (!info[0]->IsString()) {
+    return Nan::ThrowTypeError(
+        "setHealthStatus's first argument must be a service name");
+  }
+  if (!info[1]->IsUint32()) {
+    return Nan::ThrowTypeError(
+        "setHealthStatus's second argument must be a serving status");
+  }
+  Server *server = ObjectWrap::Unwrap<Server>(info.This());
+  if (!server->health_check) {
+    return Nan::ThrowError(
+        "setHealthStatus requires enableHealthCheck to be called first");
+  }
+  server->health_check->SetStatus(*Utf8String(info[0]),
+                                  Nan::To<uint32_t>(info[1]).FromJust());
+}
+
 }  // namespace node
 }  // namespace grpc
@@ -19,9 +19,13 @@
 #ifndef NET_GRPC_NODE_SERVER_H_
 #define NET_GRPC_NODE_SERVER_H_
 
+#include <memory>
+
 #include <nan.h>
 #include <node.h>
+#include "call_list.h"
 #include "grpc/grpc.h"
+#include "health_check.h"
 
 namespace grpc {
 namespace node {
@@ -40,6 +44,9 @@ class Server : public Nan::ObjectWrap {
 
   void FinishShutdown();
 
+  /* Returns the list of live calls received by this server */
+  CallList *GetLiveCalls();
+
  private:
   explicit Server(grpc_server *server);
   ~Server();
@@ -56,12 +63,18 @@ class Server : public Nan::ObjectWrap {
   static NAN_METHOD(Start);
   static NAN_METHOD(TryShutdown);
   static NAN_METHOD(ForceShutdown);
+  static NAN_METHOD(CancelAll);
+  static NAN_METHOD(EnableHealthCheck);
+  static NAN_METHOD(SetHealthStatus);
   static Nan::Callback *constructor;
   static Nan::Persistent<v8::FunctionTemplate> fun_tpl;
   Nan::Persistent<v8::Value> running_self_ref;
 
   grpc_server *wrapped_server;
   bool is_shutdown;
+  CallList live_calls;
+  // Set if grpc.health.v1.Health/Check is answered natively
+  std::unique_ptr<HealthCheckService> health_check;
 };
 
 }  // namespace node
@@ -24,6 +24,7 @@
 #include "grpc/grpc.h"
 #include "grpc/grpc_security.h"
 #include "grpc/support/log.h"
+#include "node_grpc.h"
 #include "server_credentials.h"
 #include "util.h"
 
@@ -65,7 +66,7 @@ void ServerCredentials::Init(Local<Object> exports) {
   Nan::HandleScope scope;
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("ServerCredentials").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->InstanceTemplate()->SetInternalFieldCount(kWrappedInternalFieldCount);
   Local<Function> ctr = Nan::GetFunction(tpl).ToLocalChecked();
   Nan::Set(
       ctr, Nan::New("createSsl").ToLocalChecked(),
@@ -73,14 +74,16 @@ void ServerCredentials::Init(Local<Object> exports) {
   Nan::Set(ctr, Nan::New("createInsecure").ToLocalChecked(),
            Nan::GetFunction(Nan::New<FunctionTemplate>(CreateInsecure))
                .ToLocalChecked());
+  Nan::Set(ctr, Nan::New("createLocal").ToLocalChecked(),
+           Nan::GetFunction(Nan::New<FunctionTemplate>(CreateLocal))
+               .ToLocalChecked());
   fun_tpl.Reset(tpl);
   constructor = new Nan::Callback(ctr);
   Nan::Set(exports, Nan::New("ServerCredentials").ToLocalChecked(), ctr);
 }
 
 bool ServerCredentials::HasInstance(Local<Value> val) {
-  Nan::HandleScope scope;
-  return Nan::New(fun_tpl)->HasInstance(val);
+  return HasTypeTag(val, &fun_tpl);
 }
 
 Local<Value> ServerCredentials::WrapStruct(
@@ -113,6 +116,7 @@ NAN_METHOD(ServerCredentials::New) {
         reinterpret_cast<grpc_server_credentials *>(ext->Value());
     ServerCredentials *credentials = new ServerCredentials(creds_value);
     credentials->Wrap(info.This());
+    SetTypeTag(info.This(), &fun_tpl);
     info.GetReturnValue().Set(info.This());
   } else {
     // This should never be called directly
@@ -122,6 +126,7 @@ NAN_METHOD(ServerCredentials::New) {
 }
 
 NAN_METHOD(ServerCredentials::CreateSsl) {
+  EnsureCoreInitialized();
   Nan::HandleScope scope;
   StringOrNull root_certs;
   if (::node::Buffer::HasInstance(info[0])) {
@@ -188,5 +193,12 @@ NAN_METHOD(ServerCredentials::CreateInsecure) {
   info.GetReturnValue().Set(WrapStruct(NULL));
 }
 
+/* Local credentials only allow connections over Unix domain sockets, so a
+   peer that connects with them is known to be on the same host */
+NAN_METHOD(ServerCredentials::CreateLocal) {
+  EnsureCoreInitialized();
+  info.GetReturnValue().Set(WrapStruct(grpc_local_server_credentials_create(UDS)));
+}
+
 }  // namespace node
 }  // namespace grpc
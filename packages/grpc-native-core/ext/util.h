@@ -46,6 +46,28 @@ class StringOrNull {
   bool assigned;
 };
 
+/* Wrapped objects keep a pointer identifying their class in the internal
+   field after the one that Nan::ObjectWrap uses. Checking that pointer is
+   much cheaper than FunctionTemplate::HasInstance, which walks the object's
+   prototype chain, and it is done on nearly every native method call. Any
+   static with at least 2-byte alignment that is unique to the class can be
+   the tag */
+const int kTypeTagField = 1;
+const int kWrappedInternalFieldCount = 2;
+
+inline void SetTypeTag(v8::Local<v8::Object> object, const void *tag) {
+  Nan::SetInternalFieldPointer(object, kTypeTagField, const_cast<void *>(tag));
+}
+
+inline bool HasTypeTag(v8::Local<v8::Value> value, const void *tag) {
+  if (!value->IsObject()) {
+    return false;
+  }
+  v8::Local<v8::Object> object = value.As<v8::Object>();
+  return object->InternalFieldCount() == kWrappedInternalFieldCount &&
+         Nan::GetInternalFieldPointer(object, kTypeTagField) == tag;
+}
+
 }  // namespace node
 }  // namespace grpc
 
@@ -156,6 +156,22 @@ declare module "grpc" {
    */
   export function setLogVerbosity(verbosity: logVerbosity): void;
 
+  /**
+   * Sets whether call callbacks run in async_hooks contexts. This is enabled
+   * by default, and only affects calls started after the change. All of a
+   * call's callbacks run in the async context in which its first batch was
+   * started.
+   * @param enabled Whether to run callbacks in async contexts
+   */
+  export function setAsyncHooksEnabled(enabled: boolean): void;
+
+  /**
+   * Sets how much of a core gRPC may spend busy polling for network events
+   * while calls are in progress. 0, the default, disables busy polling.
+   * @param cpuFraction The fraction of a core to spend, from 0 to 1
+   */
+  export function setBusyPolling(cpuFraction: number): void;
+
   /**
    * Server object that stores request handlers and delegates incoming requests to those handlers
    */
@@ -164,7 +180,9 @@ declare module "grpc" {
      * Constructs a server object that stores request handlers and delegates
      * incoming requests to those handlers
      * @param options Options that should be passed to the internal server
-     *     implementation
+     *     implementation. The merge_batches option is not passed on. If it is
+     *     true, the sends that a handler starts in the same tick, such as its
+     *     metadata and a write, are started as a single batch.
      * ```
      * var server = new grpc.Server();
      * server.addProtoService(protobuf_service_descriptor, service_implementation);
@@ -217,6 +235,34 @@ declare module "grpc" {
      */
     forceShutdown(): void;
 
+    /**
+     * Answer grpc.health.v1.Health/Check calls natively, from the statuses set
+     * with setHealthStatus, so that health checks never run JavaScript. Check
+     * calls for services with no status fail with NOT_FOUND. Must be called
+     * before the server starts.
+     * @param statusMap The initial serving status of each service, by name.
+     *     The empty name is the status of the whole server
+     */
+    enableHealthCheck(statusMap?: {[service: string]: number}): void;
+
+    /**
+     * Set the status that natively answered health checks report for a
+     * service.
+     * @param service The service name
+     * @param status A grpc.health.v1.HealthCheckResponse.ServingStatus value
+     */
+    setHealthStatus(service: string, status: number): void;
+
+    /**
+     * Cancels the server's in-progress calls, without shutting it down.
+     * @param code The status code to end the calls with. Must not be OK
+     * @param details The status details to end the calls with
+     * @param methodPrefix If provided, only calls to methods whose full path
+     *     starts with this prefix are cancelled
+     * @return The number of calls that were cancelled
+     */
+    cancelAll(code: status, details: string, methodPrefix?: string): number;
+
     /**
      * Add a service to the server, with a corresponding implementation.
      * @param service The service descriptor
@@ -519,6 +565,39 @@ declare module "grpc" {
     corked?: boolean;
   }
 
+  /**
+   * A limit on the memory that gRPC core may use for the channels and servers
+   * that share it. Pass it as the `grpc.resource_quota` option when creating
+   * a client or server.
+   */
+  export class ResourceQuota {
+    /**
+     * @param size The limit in bytes
+     * @param name A name for the quota, used in core's logs
+     */
+    constructor(size: number, name?: string);
+
+    /**
+     * Changes the limit.
+     * @param size The new limit in bytes
+     */
+    resize(size: number): void;
+
+    /**
+     * Gets an estimate of how much of the quota is in use.
+     */
+    getUsage(): ResourceQuotaUsage;
+  }
+
+  export interface ResourceQuotaUsage {
+    /* The limit in bytes */
+    size: number;
+    /* The estimated number of bytes in use */
+    used: number;
+    /* The estimated fraction of the limit in use */
+    pressure: number;
+  }
+
   /**
    * A class for storing metadata. Keys are normalized to lowercase ASCII.
    */
@@ -635,6 +714,12 @@ declare module "grpc" {
      * @return The ServerCredentials
      */
     static createInsecure(): ServerCredentials;
+    /**
+     * Create server credentials that only accept connections over Unix domain
+     * sockets. The server must be bound to a "unix:" address.
+     * @return The ServerCredentials
+     */
+    static createLocal(): ServerCredentials;
     /**
      * Create SSL server credentials
      * @param rootCerts Root CA certificates for validating client certificates
@@ -971,6 +1056,13 @@ declare module "grpc" {
      * @return The insecure credentials object
      */
     createInsecure(): ChannelCredentials;
+
+    /**
+     * Create a credentials object for connecting to a server that uses local
+     * server credentials. The channel must connect to a "unix:" address.
+     * @return The local credentials object
+     */
+    createLocal(): ChannelCredentials;
   };
 
   /**
@@ -1199,6 +1291,16 @@ declare module "grpc" {
      * The credentials that should be used to make this particular call.
      */
     credentials: CallCredentials;
+    /**
+     * A positive integer that identifies a group of calls, so that they can be
+     * cancelled together with Channel.cancelAll
+     */
+    call_group?: number;
+    /**
+     * For unary calls, start the batches that are sent in the same tick as a
+     * single batch. Defaults to the client's merge_batches option.
+     */
+    merge_batches?: boolean;
     /**
      * Additional custom call options. These can be used to pass additional
      * data per-call to client interceptors
@@ -1361,6 +1463,67 @@ declare module "grpc" {
    */
   export function closeClient(clientObj: Client): void;
 
+  /**
+   * A single request made by fanOut
+   */
+  export interface FanOutRequest {
+    /**
+     * The channel to make the request on, such as the one returned by
+     * getClientChannel
+     */
+    channel: Channel;
+    /**
+     * The full method path, e.g. '/package.Service/Method'
+     */
+    method: string;
+    /**
+     * The serialized request message
+     */
+    buffer: Buffer;
+    /**
+     * Metadata to send with the request
+     */
+    metadata?: Metadata;
+  }
+
+  /**
+   * Options for fanOut
+   */
+  export interface FanOutOptions {
+    /**
+     * The deadline for every request
+     */
+    deadline?: Deadline;
+    /**
+     * Indicates which properties of the parent call should propagate to the
+     * requests. Bitwise combination of flags in `grpc.propagate`.
+     */
+    propagate_flags?: number;
+    /**
+     * A call group for every request, for Channel.cancelAll
+     */
+    call_group?: number;
+  }
+
+  /**
+   * Make a unary request for each of requests, as children of parent. All of
+   * the calls are created and started by a single native call, and callback
+   * is called once, after every request has finished.
+   * @param parent A server call to propagate the deadline and cancellation
+   *     from, or null
+   * @param requests The requests to make
+   * @param options Options that apply to every request
+   * @param callback Called with the serialized response or the error of each
+   *     request, in order
+   * @return The child calls, which can be cancelled individually
+   */
+  export function fanOut(
+    parent: ServerUnaryCall<any> | null,
+    requests: FanOutRequest[],
+    options: FanOutOptions,
+    callback: (error: Error | null, results: Array<Buffer | ServiceError>) => void,
+  ): Array<{cancel(): void}>;
+
   /**
    * A builder for gRPC status objects
    */
@@ -1608,7 +1771,19 @@ declare module "grpc" {
      * @param parentCall A server call to propagate some information from
      * @param propagateFlags A bitwise combination of elements of grpc.propagate
      *     that indicates what information to propagate from parentCall.
+     * @param callGroup A positive integer that identifies a group of calls for
+     *     cancelAll
+     */
+    createCall(method: string, deadline: Date|number, host: string|null, parentCall: Call|null, propagateFlags: number|null, callGroup?: number|null): Call;
+    /**
+     * Cancel the channel's in-progress calls. A string filter cancels the
+     * calls to methods whose full path starts with it, a number cancels the
+     * calls in that call group, and omitting it cancels every call.
+     * @param code The status code to end the calls with. Must not be OK
+     * @param details The status details to end the calls with
+     * @param filter A method prefix or a call group
+     * @return The number of calls that were cancelled
      */
-    createCall(method: string, deadline: Date|number, host: string|null, parentCall: Call|null, propagateFlags: number|null): Call;
+    cancelAll(code: status, details: string, filter?: string|number): number;
   }
 }
@@ -223,10 +223,67 @@ exports.setLogVerbosity = function setLogVerbosity(verbosity) {
   grpc.setLogVerbosity(verbosity);
 };
 
+/**
+ * Sets whether call callbacks run in async_hooks contexts, so that
+ * AsyncLocalStorage and similar tools can follow them. This is enabled by
+ * default. Disabling it saves creating an async resource for each call, and
+ * only affects calls started after the change.
+ *
+ * Each call has one async resource, created when its first batch starts. The
+ * callbacks of all of a call's batches run in that context, including batches
+ * that a stream starts later from a different context. Code that needs the
+ * context of a later write or read should capture it when starting that
+ * operation.
+ * @memberof grpc
+ * @alias grpc.setAsyncHooksEnabled
+ * @param {boolean} enabled Whether to run callbacks in async contexts
+ */
+exports.setAsyncHooksEnabled = function setAsyncHooksEnabled(enabled) {
+  grpc.setAsyncHooksEnabled(enabled);
+};
+
+/**
+ * Sets how much of a core gRPC may spend busy polling for network events
+ * while calls are in progress. Instead of sleeping until the kernel wakes it,
+ * the event loop keeps polling without waiting, which lowers latency. Once
+ * busy polling has used up its share of a 100ms window, the loop sleeps as
+ * usual for the rest of that window. 0, the default, disables busy polling.
+ * @memberof grpc
+ * @alias grpc.setBusyPolling
+ * @param {number} cpuFraction The fraction of a core to spend, from 0 to 1
+ */
+exports.setBusyPolling = function setBusyPolling(cpuFraction) {
+  grpc.setBusyPolling(cpuFraction);
+};
+
 exports.Server = server.Server;
 
 exports.Metadata = Metadata;
 
+/**
+ * A limit on the memory that gRPC core may use for the channels and servers
+ * that share it. Pass it as the `grpc.resource_quota` option when creating a
+ * client or server. When memory use nears the limit, core shrinks buffers
+ * and stops reading from connections, instead of growing without bound.
+ * @constructor grpc.ResourceQuota
+ * @param {number} size The limit in bytes
+ * @param {string=} name A name for the quota, used in core's logs
+ */
+/**
+ * Changes the limit.
+ * @name grpc.ResourceQuota#resize
+ * @function
+ * @param {number} size The new limit in bytes
+ */
+/**
+ * Gets an estimate of how much of the quota is in use.
+ * @name grpc.ResourceQuota#getUsage
+ * @function
+ * @return {{size: number, used: number, pressure: number}} The limit, the
+ *     estimated bytes in use, and the fraction of the limit in use
+ */
+exports.ResourceQuota = grpc.ResourceQuota;
+
 exports.status = constants.status;
 
 exports.propagate = constants.propagate;
@@ -257,6 +314,15 @@ exports.ServerCredentials = grpc.ServerCredentials;
  * @return {grpc.ServerCredentials}
  */
 
+/**
+ * Create server credentials that only accept connections over Unix domain
+ * sockets, which guarantees that clients are running on the same host. The
+ * server must be bound to a "unix:" address.
+ * @name grpc.ServerCredentials.createLocal
+ * @kind function
+ * @return {grpc.ServerCredentials}
+ */
+
 /**
  * A private key and certificate pair
  * @typedef {Object} grpc.ServerCredentials~keyCertPair
@@ -284,6 +350,8 @@ exports.getClientChannel = client.getClientChannel;
 
 exports.waitForClientReady = client.waitForClientReady;
 
+exports.fanOut = client.fanOut;
+
 exports.StatusBuilder = client.StatusBuilder;
 exports.ListenerBuilder = client.ListenerBuilder;
 exports.RequesterBuilder = client.RequesterBuilder;
@@ -322,6 +390,20 @@ exports.Channel = grpc.Channel;
  * @kind function
  */
 
+/**
+ * Cancel the channel's in-progress calls. The filter selects which calls are
+ * cancelled: a string cancels the calls to methods whose full path starts with
+ * it, a number cancels the calls made with that call_group option, and
+ * omitting it cancels every call
+ * @name grpc.Channel#cancelAll
+ * @kind function
+ * @param {grpc.status} code The status code to end the calls with. Must not be
+ *     OK
+ * @param {string} details The status details to end the calls with
+ * @param {(string|number)=} filter A method prefix or a call group
+ * @return {number} The number of calls that were cancelled
+ */
+
 /**
  * Return the target that this channel connects to
  * @name grpc.Channel#getTarget
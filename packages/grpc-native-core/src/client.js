@@ -351,6 +351,12 @@ ClientDuplexStream.prototype.getPeer = getPeer;
  *     {@link grpc.propagate}.
  * @property {grpc.credentials~CallCredentials} credentials The credentials that
  *     should be used to make this particular call.
+ * @property {number} call_group A positive integer that identifies a group of
+ *     calls, so that they can be cancelled together with
+ *     {@link grpc.Channel#cancelAll}.
+ * @property {boolean} merge_batches For unary calls, start the batches that
+ *     are sent in the same tick as a single batch. Defaults to the client's
+ *     merge_batches option.
  */
 
 /**
@@ -360,7 +366,9 @@ ClientDuplexStream.prototype.getPeer = getPeer;
  * @param {string} address Server address to connect to
  * @param {grpc.credentials~ChannelCredentials} credentials Credentials to use
  *     to connect to the server
- * @param {Object} options Options to apply to channel creation
+ * @param {Object} options Options to apply to channel creation. The
+ *     merge_batches option is not passed to the channel, and instead sets the
+ *     default for the merge_batches call option.
  */
 function Client(address, credentials, options) {
   var self = this;
@@ -386,13 +394,14 @@ function Client(address, credentials, options) {
   }
 
   this.$callInvocationTransformer = options.callInvocationTransformer;
+  this.$merge_batches = !!options.merge_batches;
 
   let channelOverride = options.channelOverride;
   let channelFactoryOverride = options.channelFactoryOverride;
   // Exclude channel options which have already been consumed
   const ignoredKeys = [
     'interceptors', 'interceptor_providers', 'channelOverride',
-    'channelFactoryOverride', 'callInvocationTransformer'
+    'channelFactoryOverride', 'callInvocationTransformer', 'merge_batches'
   ];
   var channel_options = Object.getOwnPropertyNames(options)
     .reduce((acc, key) => {
@@ -481,6 +490,9 @@ Client.prototype.makeUnaryRequest = function(path, serialize, deserialize,
         (typeof callback === 'function'))) {
     throw new Error('Argument mismatch in makeUnaryRequest');
   }
+  if (options.merge_batches === undefined) {
+    options.merge_batches = this.$merge_batches;
+  }
 
   var method_definition = options.method_definition = {
     path: path,
@@ -1020,6 +1032,83 @@ exports.waitForClientReady = function(client, deadline, callback) {
   Client.prototype.waitForReady.call(client, deadline, callback);
 };
 
+/**
+ * A single request made by {@link grpc.fanOut}
+ * @typedef {Object} grpc~FanOutRequest
+ * @property {grpc.Channel} channel The channel to make the request on, such as
+ *     the one returned by {@link grpc.getClientChannel}
+ * @property {string} method The full method path, e.g. '/package.Service/Method'
+ * @property {Buffer} buffer The serialized request message
+ * @property {grpc.Metadata=} metadata Metadata to send with the request
+ */
+
+/**
+ * Make a unary request for each of requests, as children of parent. All of the
+ * calls are created and started by a single native call, and callback is
+ * called once, after every request has finished.
+ * @memberof grpc
+ * @alias grpc.fanOut
+ * @param {?grpc~ServerUnaryCall} parent A server call to propagate the
+ *     deadline and cancellation from, or null
+ * @param {Array<grpc~FanOutRequest>} requests The requests to make
+ * @param {Object} options
+ * @param {grpc~Deadline=} options.deadline The deadline for every request
+ * @param {number=} options.propagate_flags A bitwise combination of elements of
+ *     grpc.propagate that indicates what information to propagate from parent
+ * @param {number=} options.call_group A call group for every request, for
+ *     {@link grpc.Channel#cancelAll}
+ * @param {function(?Error, Array<Buffer|Error>)} callback Called with the
+ *     serialized response or the error of each request, in order
+ * @return {Array<grpc.Call>} The child calls, which can be cancelled
+ *     individually
+ */
+exports.fanOut = function(parent, requests, options, callback) {
+  if (requests.length === 0) {
+    // Like every other result, this one is reported asynchronously
+    setImmediate(callback, null, []);
+    return [];
+  }
+  var core_requests = requests.map(function(request) {
+    return {
+      channel: request.channel,
+      method: request.method,
+      buffer: request.buffer,
+      metadata: request.metadata ?
+          request.metadata._getCoreRepresentation() : undefined
+    };
+  });
+  var core_options = {
+    deadline: options.deadline,
+    propagateFlags: options.propagate_flags,
+    group: options.call_group
+  };
+  function reportResults(err, results) {
+    callback(err, results.map(function(result) {
+      if (result instanceof Error) {
+        return result;
+      }
+      var status = result.status;
+      status.metadata = Metadata._fromCoreRepresentation(status.metadata);
+      if (status.code !== constants.status.OK) {
+        return common.createStatusError(status);
+      }
+      return result.read;
+    }));
+  }
+  var returned = false;
+  var children = grpc.fanOut(parent ? parent.call : null, core_requests,
+                             core_options, function(err, results) {
+    if (returned) {
+      reportResults(err, results);
+    } else {
+      // No request could be started, so the results arrived synchronously
+      setImmediate(reportResults, err, results);
+    }
+  });
+  returned = true;
+  return children;
+};
+
 exports.StatusBuilder = client_interceptors.StatusBuilder;
 exports.ListenerBuilder = client_interceptors.ListenerBuilder;
 exports.RequesterBuilder = client_interceptors.RequesterBuilder;
@@ -642,18 +642,20 @@ function getCall(channel, path, options) {
   var parent;
   var propagate_flags;
   var credentials;
+  var call_group;
   if (options) {
     deadline = options.deadline;
     host = options.host;
     parent = options.parent ? options.parent.call : undefined;
     propagate_flags = options.propagate_flags;
     credentials = options.credentials;
+    call_group = options.call_group;
   }
   if (deadline === undefined) {
     deadline = Infinity;
   }
   var call = channel.createCall(path, deadline, host,
-                                parent, propagate_flags);
+                                parent, propagate_flags, call_group);
   if (credentials) {
     call.setCredentials(credentials);
   }
@@ -786,6 +788,11 @@ function _getUnaryInterceptor(method_definition, channel, emitter, callback) {
   var deserialize = method_definition.responseDeserialize;
   return function (options) {
     var call = getCall(channel, method_definition.path, options);
+    /* The metadata and message usually arrive in one tick, so with merging
+     * on they are started as a single batch */
+    if (options && options.merge_batches) {
+      call.setBatchMerging(true);
+    }
     var first_listener;
     var final_requester = {};
     var batch_state = {
@@ -274,3 +274,13 @@ exports.combineCallCredentials = function() {
  * @return {grpc.credentials~ChannelCredentials} The insecure credentials object
  */
 exports.createInsecure = ChannelCredentials.createInsecure;
+
+/**
+ * Create a credentials object for connecting to a server that uses local
+ * server credentials. The channel must connect to a "unix:" address.
+ * @memberof grpc.credentials
+ * @alias grpc.credentials.createLocal
+ * @kind function
+ * @return {grpc.credentials~ChannelCredentials} The local credentials object
+ */
+exports.createLocal = ChannelCredentials.createLocal;
@@ -18,8 +18,6 @@
 
 'use strict';
 
-var clone = require('lodash.clone');
-
 var grpc = require('./grpc_extension');
 
 const IDEMPOTENT_REQUEST_FLAG = 0x10;
@@ -50,36 +48,10 @@ const CORKED_FLAG = 0x100;
  * metadata.get('key1') // returns ['value1', 'value2']
  */
 function Metadata(options) {
-  this._internal_repr = {};
+  this._internal_repr = new grpc.Metadata();
   this.setOptions(options);
 }
 
-function normalizeKey(key) {
-  key = key.toLowerCase();
-  if (grpc.metadataKeyIsLegal(key)) {
-    return key;
-  } else {
-    throw new Error('Metadata key"' + key + '" contains illegal characters');
-  }
-}
-
-function validate(key, value) {
-  if (grpc.metadataKeyIsBinary(key)) {
-    if (!(value instanceof Buffer)) {
-      throw new Error('keys that end with \'-bin\' must have Buffer values');
-    }
-  } else {
-    if (typeof value !== 'string') {
-      throw new Error(
-          'keys that don\'t end with \'-bin\' must have String values');
-    }
-    if (!grpc.metadataNonbinValueIsLegal(value)) {
-      throw new Error('Metadata string value "' + value +
-                      '" contains illegal characters');
-    }
-  }
-}
-
 /**
  * Sets the given value for the given key, replacing any other values associated
  * with that key. Normalizes the key.
@@ -88,9 +60,7 @@ function validate(key, value) {
  *     if the normalized key ends with '-bin'
  */
 Metadata.prototype.set = function(key, value) {
-  key = normalizeKey(key);
-  validate(key, value);
-  this._internal_repr[key] = [value];
+  this._internal_repr.set(key, value);
 };
 
 /**
@@ -100,12 +70,7 @@ Metadata.prototype.set = function(key, value) {
  *     if the normalized key ends with '-bin'
  */
 Metadata.prototype.add = function(key, value) {
-  key = normalizeKey(key);
-  validate(key, value);
-  if (!this._internal_repr[key]) {
-    this._internal_repr[key] = [];
-  }
-  this._internal_repr[key].push(value);
+  this._internal_repr.add(key, value);
 };
 
 /**
@@ -113,10 +78,7 @@ Metadata.prototype.add = function(key, value) {
  * @param {String} key The key to remove
  */
 Metadata.prototype.remove = function(key) {
-  key = normalizeKey(key);
-  if (Object.prototype.hasOwnProperty.call(this._internal_repr, key)) {
-    delete this._internal_repr[key];
-  }
+  this._internal_repr.remove(key);
 };
 
 /**
@@ -125,12 +87,7 @@ Metadata.prototype.remove = function(key) {
  * @return {Array.<String|Buffer>} The values associated with that key
  */
 Metadata.prototype.get = function(key) {
-  key = normalizeKey(key);
-  if (Object.prototype.hasOwnProperty.call(this._internal_repr, key)) {
-    return this._internal_repr[key];
-  } else {
-    return [];
-  }
+  return this._internal_repr.get(key);
 };
 
 /**
@@ -139,14 +96,7 @@ Metadata.prototype.get = function(key) {
  * @return {Object.<String,String|Buffer>} A key/value mapping of the metadata
  */
 Metadata.prototype.getMap = function() {
-  var result = {};
-  Object.keys(this._internal_repr).forEach(key => {
-    const values = this._internal_repr[key];
-    if(values.length > 0) {
-      result[key] = values[0];
-    }
-  });
-  return result;
+  return this._internal_repr.getMap();
 };
 
 /**
@@ -154,11 +104,8 @@ Metadata.prototype.getMap = function() {
  * @return {grpc.Metadata} The new cloned object
  */
 Metadata.prototype.clone = function() {
-  var copy = new Metadata();
-  Object.keys(this._internal_repr).forEach(key => {
-    const value = this._internal_repr[key];
-    copy._internal_repr[key] = clone(value);
-  });
+  var copy = Object.create(Metadata.prototype);
+  copy._internal_repr = this._internal_repr.clone();
   copy.flags = this.flags;
   return copy;
 };
@@ -202,7 +149,11 @@ Metadata.prototype.setOptions = function(options) {
 /**
  * Metadata representation as passed to and the native addon
  * @typedef {object} grpc~CoreMetadata
- * @param {Object.<String, Array.<String|Buffer>>} metadata The metadata
+ * @param {Object} metadata The native metadata object. Metadata received from
+ *     core is instead a plain object that maps each key to an array of its
+ *     values, which is only created when it is first read
+ * @param {Object=} native_metadata The native metadata object holding the
+ *     entries of metadata received from core
  * @param {number} flags Metadata flags
  */
 
@@ -227,14 +178,25 @@ Metadata.prototype._getCoreRepresentation = function() {
  * @return {Metadata} The new Metadata object
  */
 Metadata._fromCoreRepresentation = function(metadata) {
-  var newMetadata = new Metadata();
-  if (metadata) {
+  if (!metadata) {
+    return new Metadata();
+  }
+  var newMetadata = Object.create(Metadata.prototype);
+  newMetadata.flags = metadata.flags;
+  if (metadata.native_metadata instanceof grpc.Metadata) {
+    // Cloning only takes new references to the received entries
+    newMetadata._internal_repr = metadata.native_metadata.clone();
+  } else if (metadata.metadata instanceof grpc.Metadata) {
+    // Another Metadata object may still own this one
+    newMetadata._internal_repr = metadata.metadata.clone();
+  } else {
+    newMetadata._internal_repr = new grpc.Metadata();
     Object.keys(metadata.metadata).forEach(key => {
-      const value = metadata.metadata[key];
-      newMetadata._internal_repr[key] = clone(value);
+      metadata.metadata[key].forEach(value => {
+        newMetadata._internal_repr.add(key, value);
+      });
     });
   }
-  newMetadata.flags = metadata.flags;
   return newMetadata;
 };
 
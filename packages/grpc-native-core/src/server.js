@@ -509,22 +509,20 @@ ServerDuplexStream.prototype.getPeer = getPeer;
 
 /**
  * Wait for the client to close, then emit a cancelled event if the client
- * cancelled.
+ * cancelled. The callback is only called for cancelled calls, so calls that
+ * end normally never return to JavaScript for this.
  * @private
  */
 function waitForCancel() {
   /* jshint validthis: true */
   var self = this;
-  var cancel_batch = {};
-  cancel_batch[grpc.opType.RECV_CLOSE_ON_SERVER] = true;
-  self.call.startBatch(cancel_batch, function(err, result) {
+  self.call.watchCancel(function(err) {
     if (err) {
       self.emit('error', err);
+      return;
     }
-    if (result.cancelled) {
-      self.cancelled = true;
-      self.emit('cancelled');
-    }
+    self.cancelled = true;
+    self.emit('cancelled');
   });
 }
 
@@ -719,7 +717,9 @@ var streamHandlers = {
  * @memberof grpc
  * @constructor
  * @param {Object=} options Options that should be passed to the internal server
- *     implementation
+ *     implementation. The merge_batches option is not passed on. If it is
+ *     true, the sends that a handler starts in the same tick, such as its
+ *     metadata and a write, are started as a single batch.
  * @example
  * var server = new grpc.Server();
  * server.addProtoService(protobuf_service_descriptor, service_implementation);
@@ -728,6 +728,12 @@ var streamHandlers = {
  */
 function Server(options) {
   this.handlers = {};
+  this._merge_batches = false;
+  if (options && options.merge_batches !== undefined) {
+    this._merge_batches = !!options.merge_batches;
+    options = Object.assign({}, options);
+    delete options.merge_batches;
+  }
   var server = new grpc.Server(options);
   this._server = server;
   this.started = false;
@@ -778,6 +784,9 @@ Server.prototype.start = function() {
       call.startBatch(batch, function() {});
       return;
     }
+    if (self._merge_batches) {
+      call.setBatchMerging(true);
+    }
     streamHandlers[handler.type](call, handler, metadata);
   }
   this._server.requestCall(handleNewCall);
@@ -839,6 +848,47 @@ Server.prototype.forceShutdown = function() {
   this._server.forceShutdown();
 };
 
+/**
+ * Answer grpc.health.v1.Health/Check calls natively, from the statuses set
+ * with setHealthStatus, so that health checks never run JavaScript. Check
+ * calls for services with no status fail with NOT_FOUND. Must be called before
+ * the server starts. Any JavaScript handler for Check is no longer called, but
+ * other methods of the Health service are not affected.
+ * @param {Object<string, number>=} statusMap The initial serving status of
+ *     each service, by name. The empty name is the status of the whole server
+ */
+Server.prototype.enableHealthCheck = function(statusMap) {
+  var self = this;
+  this._server.enableHealthCheck();
+  Object.keys(statusMap || {}).forEach(function(service) {
+    self._server.setHealthStatus(service, statusMap[service]);
+  });
+};
+
+/**
+ * Set the status that natively answered health checks report for a service.
+ * @param {string} service The service name
+ * @param {number} status A grpc.health.v1.HealthCheckResponse.ServingStatus
+ *     value
+ */
+Server.prototype.setHealthStatus = function(service, status) {
+  this._server.setHealthStatus(service, status);
+};
+
+/**
+ * Cancels the server's in-progress calls, without shutting it down.
+ * @param {grpc.status} code The status code to end the calls with. Must not be
+ *     OK
+ * @param {string} details The status details to end the calls with
+ * @param {string=} method_prefix If provided, only calls to methods whose
+ *     full path starts with this prefix, e.g. '/package.Service/', are
+ *     cancelled
+ * @return {number} The number of calls that were cancelled
+ */
+Server.prototype.cancelAll = function(code, details, method_prefix) {
+  return this._server.cancelAll(code, details, method_prefix);
+};
+
 var unimplementedStatusResponse = {
   code: constants.status.UNIMPLEMENTED,
   details: 'The server does not implement this method'
@@ -39,10 +39,11 @@ var insecureCreds = grpc.ChannelCredentials.createInsecure();
 describe('call', function() {
   var channel;
   var server;
+  var port;
   before(function() {
     server = new grpc.Server();
-    var port = server.addHttp2Port('localhost:0',
-                                   grpc.ServerCredentials.createInsecure());
+    port = server.addHttp2Port('localhost:0',
+                               grpc.ServerCredentials.createInsecure());
     server.start();
     channel = new grpc.Channel('localhost:' + port, insecureCreds);
   });
@@ -123,6 +124,115 @@ describe('call', function() {
       });
     });
   });
+  describe('async hooks', function() {
+    var async_hooks = require('async_hooks');
+    after(function() {
+      grpc.setAsyncHooksEnabled(true);
+    });
+    it('should run a call\'s callbacks in one async context', function(done) {
+      var call = channel.createCall('method', getDeadline(1));
+      call.startBatch({}, function(err) {
+        assert.ifError(err);
+        var first_id = async_hooks.executionAsyncId();
+        call.startBatch({}, function(err) {
+          assert.ifError(err);
+          assert.strictEqual(async_hooks.executionAsyncId(), first_id);
+          done();
+        });
+      });
+    });
+    it('should run later batches\' callbacks in the first batch\'s context',
+       function(done) {
+      if (!async_hooks.AsyncLocalStorage) {
+        this.skip();
+      }
+      var storage = new async_hooks.AsyncLocalStorage();
+      var call = channel.createCall('method', getDeadline(1));
+      storage.run('first', function() {
+        call.startBatch({}, function(err) {
+          assert.ifError(err);
+          storage.run('second', function() {
+            call.startBatch({}, function(err) {
+              assert.ifError(err);
+              assert.strictEqual(storage.getStore(), 'first');
+              done();
+            });
+          });
+        });
+      });
+    });
+    it('should still run callbacks when disabled', function(done) {
+      grpc.setAsyncHooksEnabled(false);
+      var call = channel.createCall('method', getDeadline(1));
+      call.startBatch({}, function(err) {
+        assert.ifError(err);
+        done();
+      });
+    });
+    it('should reject non-boolean arguments', function() {
+      assert.throws(function() {
+        grpc.setAsyncHooksEnabled('no');
+      }, TypeError);
+    });
+  });
+  describe('batch merging', function() {
+    it('should give each batch only its own results', function(done) {
+      var call = channel.createCall('method', getDeadline(1));
+      call.setBatchMerging(true);
+      var send_done = false;
+      var send_batch = {};
+      send_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+      call.startBatch(send_batch, function(err, response) {
+        assert.ifError(err);
+        assert.deepEqual(response, {'send_metadata': true});
+        send_done = true;
+      });
+      var close_batch = {};
+      close_batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
+      call.startBatch(close_batch, function(err, response) {
+        assert.ifError(err);
+        assert(send_done);
+        assert.deepEqual(response, {'client_close': true});
+        done();
+      });
+    });
+    it('should not make sends wait for a receiving batch', function(done) {
+      var call = channel.createCall('method', Infinity);
+      call.setBatchMerging(true);
+      var send_batch = {};
+      send_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+      call.startBatch(send_batch, function(err, response) {
+        assert.ifError(err);
+        assert.deepEqual(response, {'send_metadata': true});
+        // The status only arrives once the call is cancelled
+        call.cancel();
+      });
+      var status_batch = {};
+      status_batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+      call.startBatch(status_batch, function(err, response) {
+        assert.strictEqual(response.status.code, constants.status.CANCELLED);
+        done();
+      });
+    });
+    it('should start merged batches when flushed', function(done) {
+      var call = channel.createCall('method', getDeadline(1));
+      call.setBatchMerging(true);
+      var batch = {};
+      batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+      call.startBatch(batch, function(err, response) {
+        assert.ifError(err);
+        assert.deepEqual(response, {'send_metadata': true});
+        done();
+      });
+      call.flushBatches();
+    });
+    it('should reject non-boolean arguments', function() {
+      var call = channel.createCall('method', getDeadline(1));
+      assert.throws(function() {
+        call.setBatchMerging('yes');
+      }, TypeError);
+    });
+  });
   describe('startBatch with metadata', function() {
     it('should succeed with a map of strings to string arrays', function(done) {
       var call = channel.createCall('method', getDeadline(1));
@@ -326,10 +436,122 @@ describe('call', function() {
       call.cancelWithStatus(5, 'details');
     });
   });
+  describe('cancelAll', function() {
+    var local_channel;
+    beforeEach(function() {
+      local_channel = new grpc.Channel('localhost:' + port, insecureCreds);
+    });
+    afterEach(function() {
+      local_channel.close();
+    });
+    function startStatusBatch(call, callback) {
+      var batch = {};
+      batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+      call.startBatch(batch, function(err, response) {
+        callback(response.status);
+      });
+    }
+    it('should reject the OK status code', function() {
+      assert.throws(function() {
+        local_channel.cancelAll(0, 'details');
+      }, RangeError);
+    });
+    it('should reject filters of other types', function() {
+      assert.throws(function() {
+        local_channel.cancelAll(5, 'details', {});
+      }, TypeError);
+    });
+    it('should cancel only the calls in a group', function(done) {
+      var grouped = local_channel.createCall('method', getDeadline(1), null,
+                                             null, null, 7);
+      var other = local_channel.createCall('method', getDeadline(1), null,
+                                           null, null, 8);
+      startStatusBatch(grouped, function(status) {
+        assert.strictEqual(status.code, 5);
+        assert.strictEqual(status.details, 'details');
+        other.cancel();
+        done();
+      });
+      assert.strictEqual(local_channel.cancelAll(5, 'details', 7), 1);
+    });
+    it('should cancel only the calls matching a method prefix', function(done) {
+      var matching = local_channel.createCall('/Service/method',
+                                              getDeadline(1));
+      local_channel.createCall('/OtherService/method', getDeadline(1));
+      startStatusBatch(matching, function(status) {
+        assert.strictEqual(status.code, 5);
+        done();
+      });
+      assert.strictEqual(local_channel.cancelAll(5, 'details', '/Service/'),
+                         1);
+    });
+    it('should not count calls that have finished', function(done) {
+      var call = local_channel.createCall('method', getDeadline(1));
+      startStatusBatch(call, function(status) {
+        // The call leaves the list after its final batch callback returns
+        setImmediate(function() {
+          assert.strictEqual(local_channel.cancelAll(5, 'details'), 0);
+          done();
+        });
+      });
+      call.cancel();
+    });
+  });
   describe('getPeer', function() {
     it('should return a string', function() {
       var call = channel.createCall('method', getDeadline(1));
       assert.strictEqual(typeof call.getPeer(), 'string');
     });
+    it('should reject objects that are not calls', function() {
+      var call = channel.createCall('method', getDeadline(1));
+      assert.throws(function() {
+        call.getPeer.call(Object.create(grpc.Call.prototype));
+      }, TypeError);
+      assert.throws(function() {
+        call.getPeer.call(channel);
+      }, TypeError);
+      assert.throws(function() {
+        call.getPeer.call(new grpc.Metadata());
+      }, TypeError);
+    });
   });
 });
+
+describe('fanOut without a server', function() {
+  var channel;
+  before(function() {
+    /* No server's batches are pending here, so nothing else keeps the
+       completion queue running while the children complete */
+    var server = new grpc.Server();
+    var port = server.addHttp2Port('localhost:0',
+                                   grpc.ServerCredentials.createInsecure());
+    server.start();
+    server.forceShutdown();
+    channel = new grpc.Channel('localhost:' + port, insecureCreds);
+  });
+  after(function() {
+    channel.close();
+  });
+  it('should leave the completion queue running for later calls',
+     function(done) {
+       var requests = [0, 1, 2].map(function() {
+         return {channel: channel, method: 'dummy_method',
+                 buffer: Buffer.from('')};
+       });
+       grpc.fanOut(null, requests, {deadline: getDeadline(1)},
+                   function(err, results) {
+         assert.ifError(err);
+         assert.strictEqual(results.length, 3);
+         var call = channel.createCall('dummy_method', getDeadline(1));
+         var batch = {};
+         batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+         batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
+         batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+         call.startBatch(batch, function(err, response) {
+           assert.ifError(err);
+           assert.notStrictEqual(response.status.code, constants.status.OK);
+           done();
+         });
+       });
+     });
+});
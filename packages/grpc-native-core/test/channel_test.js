@@ -89,6 +89,16 @@ describe('channel', function() {
         new grpc.Channel('hostname', insecureCreds, {'key' : new Date()});
       });
     });
+    it('should accept a ResourceQuota as grpc.resource_quota', function() {
+      var quota = new grpc.ResourceQuota(1024 * 1024);
+      assert.doesNotThrow(function() {
+        new grpc.Channel('hostname', insecureCreds,
+                         {'grpc.resource_quota': quota});
+      });
+      assert.throws(function() {
+        new grpc.Channel('hostname', insecureCreds, {'key': quota});
+      });
+    });
     it('should succeed without the new keyword', function() {
       assert.doesNotThrow(function() {
         var channel = grpc.Channel('hostname', insecureCreds);
@@ -96,6 +106,28 @@ describe('channel', function() {
       });
     });
   });
+  describe('ResourceQuota', function() {
+    it('should require a non-negative size', function() {
+      assert.throws(function() {
+        new grpc.ResourceQuota();
+      }, TypeError);
+      assert.throws(function() {
+        new grpc.ResourceQuota(-1);
+      }, TypeError);
+      assert.doesNotThrow(function() {
+        new grpc.ResourceQuota(1024, 'quota name');
+      });
+    });
+    it('should report its size after resizing', function() {
+      var quota = new grpc.ResourceQuota(1024);
+      assert.strictEqual(quota.getUsage().size, 1024);
+      quota.resize(4096);
+      var usage = quota.getUsage();
+      assert.strictEqual(usage.size, 4096);
+      assert(usage.used >= 0 && usage.used <= usage.size);
+      assert(usage.pressure >= 0 && usage.pressure <= 1);
+    });
+  });
   describe('close', function() {
     var channel;
     beforeEach(function() {
@@ -20,6 +20,7 @@
 
 var assert = require('assert');
 var fs = require('fs');
+var os = require('os');
 var path = require('path');
 var forge = require('node-forge');
 
@@ -224,6 +225,51 @@ describe('server credentials', function() {
   });
 });
 
+describe('local credentials', function() {
+  var Client;
+  var server;
+  var socket_path = path.join(os.tmpdir(),
+                              'grpc_node_local_' + process.pid + '.sock');
+  var server_peer;
+  before(function() {
+    if (process.platform === 'win32') {
+      this.skip();
+    }
+    var proto = grpc.load(__dirname + '/test_service.proto');
+    server = new grpc.Server();
+    server.addService(proto.TestService.service, {
+      unary: function(call, cb) {
+        server_peer = call.getPeer();
+        cb(null, {});
+      }
+    });
+    server.bind('unix:' + socket_path, grpc.ServerCredentials.createLocal());
+    server.start();
+    Client = proto.TestService;
+  });
+  after(function() {
+    if (server) {
+      server.forceShutdown();
+    }
+    try {
+      fs.unlinkSync(socket_path);
+    } catch (e) {
+      if (e.code !== 'ENOENT') {
+        throw e;
+      }
+    }
+  });
+  it('Should connect over a Unix domain socket', function(done) {
+    var client = new Client('unix:' + socket_path,
+                            grpc.credentials.createLocal());
+    client.unary({}, function(err, data) {
+      assert.ifError(err);
+      assert(server_peer.startsWith('unix:'));
+      done();
+    });
+  });
+});
+
 describe('client credentials', function() {
   var Client;
   var server;
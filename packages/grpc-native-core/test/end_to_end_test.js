@@ -19,8 +19,12 @@
 'use strict';
 
 var assert = require('assert');
+var fs = require('fs');
+var os = require('os');
+var path = require('path');
 var grpc = require('../src/grpc_extension');
 var constants = require('../src/constants');
+var Metadata = require('../src/metadata');
 
 /**
  * This is used for testing functions with multiple asynchronous calls that
@@ -45,6 +49,68 @@ function multiDone(done, count) {
 
 var insecureCreds = grpc.ChannelCredentials.createInsecure();
 
+/**
+ * Makes a call on channel that sends and receives one message, and handles it
+ * on server.
+ * @param {grpc.Server} server A started server
+ * @param {grpc.Channel} channel A channel connected to server
+ * @param {function()} complete Called when the test is complete
+ */
+function sendAndReceiveData(server, channel, complete) {
+  var req_text = 'client_request';
+  var reply_text = 'server_response';
+  var done = multiDone(complete, 2);
+  var status_text = 'success';
+  var call = channel.createCall('dummy_method', Infinity);
+  var client_batch = {};
+  client_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+  client_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(req_text);
+  client_batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
+  client_batch[grpc.opType.RECV_INITIAL_METADATA] = true;
+  client_batch[grpc.opType.RECV_MESSAGE] = true;
+  client_batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+  call.startBatch(client_batch, function(err, response) {
+    assert.ifError(err);
+    assert(response.send_metadata);
+    assert(response.client_close);
+    assert.deepEqual(response.metadata, {metadata: {}, flags: 0});
+    assert(response.send_message);
+    assert.strictEqual(response.read.toString(), reply_text);
+    assert.deepEqual(response.status, {code: constants.status.OK,
+                                       details: status_text,
+                                       metadata: {metadata: {}, flags: 0}});
+    done();
+  });
+
+  server.requestCall(function(err, call_details) {
+    var new_call = call_details.new_call;
+    assert.notEqual(new_call, null);
+    var server_call = new_call.call;
+    assert.notEqual(server_call, null);
+    var server_batch = {};
+    server_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+    server_batch[grpc.opType.RECV_MESSAGE] = true;
+    server_call.startBatch(server_batch, function(err, response) {
+      assert.ifError(err);
+      assert(response.send_metadata);
+      assert.strictEqual(response.read.toString(), req_text);
+      var response_batch = {};
+      response_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(reply_text);
+      response_batch[grpc.opType.SEND_STATUS_FROM_SERVER] = {
+        metadata: {metadata: {}},
+        code: constants.status.OK,
+        details: status_text
+      };
+      response_batch[grpc.opType.RECV_CLOSE_ON_SERVER] = true;
+      server_call.startBatch(response_batch, function(err, response) {
+        assert(response.send_status);
+        assert(!response.cancelled);
+        done();
+      });
+    });
+  });
+}
+
 describe('end-to-end', function() {
   var server;
   var channel;
@@ -114,6 +180,50 @@ describe('end-to-end', function() {
       });
     });
   });
+  describe('with busy polling', function() {
+    before(function() {
+      grpc.setBusyPolling(0.5);
+    });
+    after(function() {
+      grpc.setBusyPolling(0);
+    });
+    it('should complete a request', function(complete) {
+      var done = multiDone(complete, 2);
+      var call = channel.createCall('dummy_method', Infinity);
+      var client_batch = {};
+      client_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+      client_batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
+      client_batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+      call.startBatch(client_batch, function(err, response) {
+        assert.ifError(err);
+        assert.strictEqual(response.status.code, constants.status.OK);
+        done();
+      });
+      server.requestCall(function(err, call_details) {
+        var server_call = call_details.new_call.call;
+        var server_batch = {};
+        server_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+        server_batch[grpc.opType.SEND_STATUS_FROM_SERVER] = {
+          metadata: {metadata: {}},
+          code: constants.status.OK,
+          details: ''
+        };
+        server_batch[grpc.opType.RECV_CLOSE_ON_SERVER] = true;
+        server_call.startBatch(server_batch, function(err) {
+          assert.ifError(err);
+          done();
+        });
+      });
+    });
+    it('should reject budgets outside of 0 to 1', function() {
+      assert.throws(function() {
+        grpc.setBusyPolling(2);
+      }, RangeError);
+      assert.throws(function() {
+        grpc.setBusyPolling('all');
+      }, TypeError);
+    });
+  });
   it('should successfully send and receive metadata', function(complete) {
     var done = multiDone(complete, 2);
     var status_text = 'xyz';
@@ -150,6 +260,9 @@ describe('end-to-end', function() {
       assert.notEqual(new_call, null);
       assert.strictEqual(new_call.metadata.metadata.client_key[0],
                          'client_value');
+      assert.deepStrictEqual(
+          Metadata._fromCoreRepresentation(new_call.metadata).get('client_key'),
+          ['client_value']);
       var server_call = new_call.call;
       assert.notEqual(server_call, null);
       var server_batch = {};
@@ -176,60 +289,7 @@ describe('end-to-end', function() {
     });
   });
   it('should send and receive data without error', function(complete) {
-    var req_text = 'client_request';
-    var reply_text = 'server_response';
-    var done = multiDone(complete, 2);
-    var status_text = 'success';
-    var call = channel.createCall(
-                             'dummy_method',
-                             Infinity);
-    var client_batch = {};
-    client_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
-    client_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(req_text);
-    client_batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
-    client_batch[grpc.opType.RECV_INITIAL_METADATA] = true;
-    client_batch[grpc.opType.RECV_MESSAGE] = true;
-    client_batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
-    call.startBatch(client_batch, function(err, response) {
-      assert.ifError(err);
-      assert(response.send_metadata);
-      assert(response.client_close);
-      assert.deepEqual(response.metadata, {metadata: {}, flags: 0});
-      assert(response.send_message);
-      assert.strictEqual(response.read.toString(), reply_text);
-      assert.deepEqual(response.status, {code: constants.status.OK,
-                                         details: status_text,
-                                         metadata: {metadata: {}, flags: 0}});
-      done();
-    });
-
-    server.requestCall(function(err, call_details) {
-      var new_call = call_details.new_call;
-      assert.notEqual(new_call, null);
-      var server_call = new_call.call;
-      assert.notEqual(server_call, null);
-      var server_batch = {};
-      server_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
-      server_batch[grpc.opType.RECV_MESSAGE] = true;
-      server_call.startBatch(server_batch, function(err, response) {
-        assert.ifError(err);
-        assert(response.send_metadata);
-        assert.strictEqual(response.read.toString(), req_text);
-        var response_batch = {};
-        response_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(reply_text);
-        response_batch[grpc.opType.SEND_STATUS_FROM_SERVER] = {
-          metadata: {metadata: {}},
-          code: constants.status.OK,
-          details: status_text
-        };
-        response_batch[grpc.opType.RECV_CLOSE_ON_SERVER] = true;
-        server_call.startBatch(response_batch, function(err, response) {
-          assert(response.send_status);
-          assert(!response.cancelled);
-          done();
-        });
-      });
-    });
+    sendAndReceiveData(server, channel, complete);
   });
   it('should send multiple messages', function(complete) {
     var done = multiDone(complete, 2);
@@ -302,4 +362,238 @@ describe('end-to-end', function() {
       });
     });
   });
+  it('should not hold a merged write until a message arrives',
+     function(complete) {
+    var done = multiDone(complete, 2);
+    var requests = ['req1', 'req2'];
+    var reply = 'reply';
+    var call = channel.createCall('dummy_method', Infinity);
+    call.setBatchMerging(true);
+    var write_batch = {};
+    write_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+    write_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(requests[0]);
+    call.startBatch(write_batch, function(err, response) {
+      assert.ifError(err);
+      assert.deepEqual(response, {send_metadata: true, send_message: true});
+      // Like a stream, only write the next message once this one is written
+      var next_batch = {};
+      next_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(requests[1]);
+      next_batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
+      call.startBatch(next_batch, function(err, response) {
+        assert.ifError(err);
+      });
+    });
+    var read_batch = {};
+    read_batch[grpc.opType.RECV_INITIAL_METADATA] = true;
+    read_batch[grpc.opType.RECV_MESSAGE] = true;
+    call.startBatch(read_batch, function(err, response) {
+      assert.ifError(err);
+      assert.strictEqual(response.read.toString(), reply);
+      var status_batch = {};
+      status_batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+      call.startBatch(status_batch, function(err, response) {
+        assert.ifError(err);
+        assert.strictEqual(response.status.code, constants.status.OK);
+        done();
+      });
+    });
+
+    server.requestCall(function(err, call_details) {
+      var server_call = call_details.new_call.call;
+      var read_batch = {};
+      read_batch[grpc.opType.RECV_MESSAGE] = true;
+      server_call.startBatch(read_batch, function(err, response) {
+        assert.ifError(err);
+        assert.strictEqual(response.read.toString(), requests[0]);
+        // The server only replies after the second message
+        server_call.startBatch(read_batch, function(err, response) {
+          assert.ifError(err);
+          assert.strictEqual(response.read.toString(), requests[1]);
+          var end_batch = {};
+          end_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+          end_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(reply);
+          end_batch[grpc.opType.RECV_CLOSE_ON_SERVER] = true;
+          end_batch[grpc.opType.SEND_STATUS_FROM_SERVER] = {
+            metadata: {metadata: {}},
+            code: constants.status.OK,
+            details: ''
+          };
+          server_call.startBatch(end_batch, function(err, response) {
+            assert.ifError(err);
+            assert(response.send_status);
+            done();
+          });
+        });
+      });
+    });
+  });
+  it('should keep both peers after the call completes', function(complete) {
+    var done = multiDone(complete, 2);
+    var call = channel.createCall('dummy_method', Infinity);
+    var client_batch = {};
+    client_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+    client_batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
+    client_batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+    call.startBatch(client_batch, function(err, response) {
+      assert.ifError(err);
+      // The call is released once this callback returns
+      setImmediate(function() {
+        var peer = call.getPeer();
+        assert.notStrictEqual(peer, 'unknown');
+        // The first getPeer releases the completed call
+        assert.strictEqual(call.getPeer(), peer);
+        done();
+      });
+    });
+
+    server.requestCall(function(err, call_details) {
+      var server_call = call_details.new_call.call;
+      var server_batch = {};
+      server_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+      server_batch[grpc.opType.SEND_STATUS_FROM_SERVER] = {
+        metadata: {metadata: {}},
+        code: constants.status.OK,
+        details: ''
+      };
+      server_batch[grpc.opType.RECV_CLOSE_ON_SERVER] = true;
+      server_call.startBatch(server_batch, function(err, response) {
+        assert.ifError(err);
+        setImmediate(function() {
+          assert.notStrictEqual(server_call.getPeer(), 'unknown');
+          done();
+        });
+      });
+    });
+  });
+  it('should report cancellation to watchCancel', function(done) {
+    var call = channel.createCall('dummy_method', Infinity);
+    var client_batch = {};
+    client_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+    call.startBatch(client_batch, function(err, response) {
+      assert.ifError(err);
+    });
+    server.requestCall(function(err, call_details) {
+      assert.ifError(err);
+      var server_call = call_details.new_call.call;
+      assert.strictEqual(server_call.isCancelled(), false);
+      server_call.watchCancel(function(err) {
+        assert.ifError(err);
+        assert.strictEqual(server_call.isCancelled(), true);
+        done();
+      });
+      call.cancel();
+    });
+  });
+  it('should fan out requests and aggregate their results', function(complete) {
+    var done = multiDone(complete, 3);
+    var requests = ['req1', 'req2'];
+    var children = grpc.fanOut(null, requests.map(function(request) {
+      return {
+        channel: channel,
+        method: 'dummy_method',
+        buffer: Buffer.from(request)
+      };
+    }), {deadline: Infinity}, function(err, results) {
+      assert.ifError(err);
+      assert.strictEqual(results.length, requests.length);
+      results.forEach(function(result) {
+        assert.strictEqual(result.status.code, constants.status.OK);
+        assert.strictEqual(result.read.toString(),
+                           result.status.details);
+      });
+      assert.deepEqual(results.map(function(result) {
+        return result.status.details;
+      }).sort(), requests);
+      done();
+    });
+    assert.strictEqual(children.length, requests.length);
+    function handleCall(err, call_details) {
+      assert.ifError(err);
+      var server_call = call_details.new_call.call;
+      var server_batch = {};
+      server_batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+      server_batch[grpc.opType.RECV_MESSAGE] = true;
+      server_call.startBatch(server_batch, function(err, response) {
+        assert.ifError(err);
+        var request = response.read.toString();
+        var end_batch = {};
+        end_batch[grpc.opType.SEND_MESSAGE] = Buffer.from(request);
+        end_batch[grpc.opType.RECV_CLOSE_ON_SERVER] = true;
+        end_batch[grpc.opType.SEND_STATUS_FROM_SERVER] = {
+          metadata: {metadata: {}},
+          code: constants.status.OK,
+          details: request
+        };
+        server_call.startBatch(end_batch, function(err, response) {
+          assert.ifError(err);
+          done();
+        });
+      });
+    }
+    server.requestCall(handleCall);
+    server.requestCall(handleCall);
+  });
+  it('should reject an empty list of fanOut requests', function() {
+    assert.throws(function() {
+      grpc.fanOut(null, [], {}, function() {});
+    }, RangeError);
+  });
+  it('should reject fanOut from a completed parent', function(done) {
+    var parent = channel.createCall('dummy_method', Infinity);
+    var batch = {};
+    batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+    parent.startBatch(batch, function() {
+      // The call is released once this callback returns
+      setImmediate(function() {
+        assert.throws(function() {
+          grpc.fanOut(parent, [{
+            channel: channel,
+            method: 'dummy_method',
+            buffer: Buffer.from('req')
+          }], {}, function() {});
+        }, /completed/);
+        done();
+      });
+    });
+    parent.cancel();
+  });
+  it('should reject a fanOut request without a buffer', function() {
+    assert.throws(function() {
+      grpc.fanOut(null, [{channel: channel, method: 'dummy_method'}], {},
+                  function() {});
+    }, TypeError);
+  });
+});
+
+describe('end-to-end over a Unix domain socket', function() {
+  var server;
+  var channel;
+  var socket_path = path.join(os.tmpdir(),
+                              'grpc_node_test_' + process.pid + '.sock');
+  before(function() {
+    if (process.platform === 'win32') {
+      this.skip();
+    }
+    server = new grpc.Server();
+    var port_num = server.addHttp2Port('unix:' + socket_path,
+                                       grpc.ServerCredentials.createInsecure());
+    assert(port_num > 0);
+    server.start();
+    channel = new grpc.Channel('unix:' + socket_path, insecureCreds);
+  });
+  after(function() {
+    if (server) {
+      server.forceShutdown();
+    }
+    try {
+      fs.unlinkSync(socket_path);
+    } catch (e) {
+      if (e.code !== 'ENOENT') {
+        throw e;
+      }
+    }
+  });
+  it('should send and receive data without error', function(complete) {
+    sendAndReceiveData(server, channel, complete);
+  });
 });
@@ -0,0 +1,227 @@
+// GENERATED CODE -- DO NOT EDIT!
+
+// Original file comments:
+// Copyright 2015 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+'use strict';
+var grpc = require('../..');
+var jspb = require('google-protobuf');
+var math_math_pb = require('./math_pb.js');
+
+function serialize_math_DivArgs(arg) {
+  if (!(arg instanceof math_math_pb.DivArgs)) {
+    throw new Error('Expected argument of type math.DivArgs');
+  }
+  return Buffer.from(arg.serializeBinary());
+}
+
+var pool_math_DivArgs = [];
+
+function deserializeInto_math_DivArgs(target, buffer_arg) {
+  math_math_pb.DivArgs.call(target);
+  var reader = jspb.BinaryReader.alloc(new Uint8Array(buffer_arg));
+  math_math_pb.DivArgs.deserializeBinaryFromReader(target, reader);
+  reader.free();
+  return target;
+}
+
+function deserialize_math_DivArgs(buffer_arg) {
+  if (pool_math_DivArgs.length > 0) {
+    return deserializeInto_math_DivArgs(pool_math_DivArgs.pop(), buffer_arg);
+  }
+  return math_math_pb.DivArgs.deserializeBinary(new Uint8Array(buffer_arg));
+}
+
+function serialize_math_DivReply(arg) {
+  if (!(arg instanceof math_math_pb.DivReply)) {
+    throw new Error('Expected argument of type math.DivReply');
+  }
+  return Buffer.from(arg.serializeBinary());
+}
+
+var pool_math_DivReply = [];
+
+function deserializeInto_math_DivReply(target, buffer_arg) {
+  math_math_pb.DivReply.call(target);
+  var reader = jspb.BinaryReader.alloc(new Uint8Array(buffer_arg));
+  math_math_pb.DivReply.deserializeBinaryFromReader(target, reader);
+  reader.free();
+  return target;
+}
+
+function deserialize_math_DivReply(buffer_arg) {
+  if (pool_math_DivReply.length > 0) {
+    return deserializeInto_math_DivReply(pool_math_DivReply.pop(), buffer_arg);
+  }
+  return math_math_pb.DivReply.deserializeBinary(new Uint8Array(buffer_arg));
+}
+
+function serialize_math_FibArgs(arg) {
+  if (!(arg instanceof math_math_pb.FibArgs)) {
+    throw new Error('Expected argument of type math.FibArgs');
+  }
+  return Buffer.from(arg.serializeBinary());
+}
+
+var pool_math_FibArgs = [];
+
+function deserializeInto_math_FibArgs(target, buffer_arg) {
+  math_math_pb.FibArgs.call(target);
+  var reader = jspb.BinaryReader.alloc(new Uint8Array(buffer_arg));
+  math_math_pb.FibArgs.deserializeBinaryFromReader(target, reader);
+  reader.free();
+  return target;
+}
+
+function deserialize_math_FibArgs(buffer_arg) {
+  if (pool_math_FibArgs.length > 0) {
+    return deserializeInto_math_FibArgs(pool_math_FibArgs.pop(), buffer_arg);
+  }
+  return math_math_pb.FibArgs.deserializeBinary(new Uint8Array(buffer_arg));
+}
+
+function serialize_math_Num(arg) {
+  if (!(arg instanceof math_math_pb.Num)) {
+    throw new Error('Expected argument of type math.Num');
+  }
+  return Buffer.from(arg.serializeBinary());
+}
+
+var pool_math_Num = [];
+
+function deserializeInto_math_Num(target, buffer_arg) {
+  math_math_pb.Num.call(target);
+  var reader = jspb.BinaryReader.alloc(new Uint8Array(buffer_arg));
+  math_math_pb.Num.deserializeBinaryFromReader(target, reader);
+  reader.free();
+  return target;
+}
+
+function deserialize_math_Num(buffer_arg) {
+  if (pool_math_Num.length > 0) {
+    return deserializeInto_math_Num(pool_math_Num.pop(), buffer_arg);
+  }
+  return math_math_pb.Num.deserializeBinary(new Uint8Array(buffer_arg));
+}
+
+var MAX_POOLED_MESSAGES = 64;
+
+// Deserializes buffer_arg into target, replacing its previous contents
+exports.deserializeInto = function(target, buffer_arg) {
+  if (target instanceof math_math_pb.DivArgs) {
+    return deserializeInto_math_DivArgs(target, buffer_arg);
+  }
+  if (target instanceof math_math_pb.DivReply) {
+    return deserializeInto_math_DivReply(target, buffer_arg);
+  }
+  if (target instanceof math_math_pb.FibArgs) {
+    return deserializeInto_math_FibArgs(target, buffer_arg);
+  }
+  if (target instanceof math_math_pb.Num) {
+    return deserializeInto_math_Num(target, buffer_arg);
+  }
+  throw new Error('Unexpected message type');
+};
+
+// Returns a message that is no longer used to the pool for its type,
+// so that a later deserialize call can reuse it. The message must not
+// be accessed after it has been released.
+exports.releaseMessage = function(message) {
+  if (message instanceof math_math_pb.DivArgs) {
+    if (pool_math_DivArgs.length < MAX_POOLED_MESSAGES) {
+      pool_math_DivArgs.push(message);
+    }
+    return;
+  }
+  if (message instanceof math_math_pb.DivReply) {
+    if (pool_math_DivReply.length < MAX_POOLED_MESSAGES) {
+      pool_math_DivReply.push(message);
+    }
+    return;
+  }
+  if (message instanceof math_math_pb.FibArgs) {
+    if (pool_math_FibArgs.length < MAX_POOLED_MESSAGES) {
+      pool_math_FibArgs.push(message);
+    }
+    return;
+  }
+  if (message instanceof math_math_pb.Num) {
+    if (pool_math_Num.length < MAX_POOLED_MESSAGES) {
+      pool_math_Num.push(message);
+    }
+    return;
+  }
+};
+
+
+var MathService = exports.MathService = {
+  // Div divides args.dividend by args.divisor and returns the quotient and
+  // remainder.
+  div: {
+    path: '/math.Math/Div',
+    requestStream: false,
+    responseStream: false,
+    requestType: math_math_pb.DivArgs,
+    responseType: math_math_pb.DivReply,
+    requestSerialize: serialize_math_DivArgs,
+    requestDeserialize: deserialize_math_DivArgs,
+    responseSerialize: serialize_math_DivReply,
+    responseDeserialize: deserialize_math_DivReply,
+  },
+  // DivMany accepts an arbitrary number of division args from the client stream
+  // and sends back the results in the reply stream.  The stream continues until
+  // the client closes its end; the server does the same after sending all the
+  // replies.  The stream ends immediately if either end aborts.
+  divMany: {
+    path: '/math.Math/DivMany',
+    requestStream: true,
+    responseStream: true,
+    requestType: math_math_pb.DivArgs,
+    responseType: math_math_pb.DivReply,
+    requestSerialize: serialize_math_DivArgs,
+    requestDeserialize: deserialize_math_DivArgs,
+    responseSerialize: serialize_math_DivReply,
+    responseDeserialize: deserialize_math_DivReply,
+  },
+  // Fib generates numbers in the Fibonacci sequence.  If args.limit > 0, Fib
+  // generates up to limit numbers; otherwise it continues until the call is
+  // canceled.  Unlike Fib above, Fib has no final FibReply.
+  fib: {
+    path: '/math.Math/Fib',
+    requestStream: false,
+    responseStream: true,
+    requestType: math_math_pb.FibArgs,
+    responseType: math_math_pb.Num,
+    requestSerialize: serialize_math_FibArgs,
+    requestDeserialize: deserialize_math_FibArgs,
+    responseSerialize: serialize_math_Num,
+    responseDeserialize: deserialize_math_Num,
+  },
+  // Sum sums a stream of numbers, returning the final result once the stream
+  // is closed.
+  sum: {
+    path: '/math.Math/Sum',
+    requestStream: true,
+    responseStream: false,
+    requestType: math_math_pb.Num,
+    responseType: math_math_pb.Num,
+    requestSerialize: serialize_math_Num,
+    requestDeserialize: deserialize_math_Num,
+    responseSerialize: serialize_math_Num,
+    responseDeserialize: deserialize_math_Num,
+  },
+};
+
+exports.MathClient = grpc.makeGenericClientConstructor(MathService);
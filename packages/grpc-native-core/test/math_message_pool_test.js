@@ -0,0 +1,115 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+'use strict';
+
+var assert = require('assert');
+
+var math = require('./math/math_pb');
+var math_pooled = require('./math/math_pooled_grpc_pb');
+
+var divArgsMethod = math_pooled.MathService.div;
+
+function serializeDivArgs(dividend, divisor) {
+  var arg = new math.DivArgs();
+  if (dividend) {
+    arg.setDividend(dividend);
+  }
+  arg.setDivisor(divisor);
+  return divArgsMethod.requestSerialize(arg);
+}
+
+describe('Generated message pools', function() {
+  var deserialize = divArgsMethod.requestDeserialize;
+  afterEach(function() {
+    // Drain every pool so that each test starts without pooled messages
+    var types = [];
+    Object.keys(math_pooled.MathService).forEach(function(name) {
+      var method = math_pooled.MathService[name];
+      [
+        [method.requestType, method.requestDeserialize],
+        [method.responseType, method.responseDeserialize]
+      ].forEach(function(pair) {
+        if (types.indexOf(pair[0]) >= 0) {
+          return;
+        }
+        types.push(pair[0]);
+        var buffer = Buffer.from(new pair[0]().serializeBinary());
+        for (var i = 0; i < 64; i++) {
+          pair[1](buffer);
+        }
+      });
+    });
+  });
+  it('should reuse a released message', function() {
+    var first = deserialize(serializeDivArgs(7, 3));
+    math_pooled.releaseMessage(first);
+    var second = deserialize(serializeDivArgs(8, 5));
+    assert.strictEqual(second, first);
+    assert.strictEqual(second.getDividend(), 8);
+    assert.strictEqual(second.getDivisor(), 5);
+  });
+  it('should reset fields of a reused message', function() {
+    var first = deserialize(serializeDivArgs(7, 3));
+    math_pooled.releaseMessage(first);
+    // The dividend is not on the wire, so it must not survive from before
+    var second = deserialize(serializeDivArgs(0, 5));
+    assert.strictEqual(second, first);
+    assert.strictEqual(second.getDividend(), 0);
+    assert.strictEqual(second.getDivisor(), 5);
+  });
+  it('should only reuse messages of the same type', function() {
+    var reply = new math.DivReply();
+    math_pooled.releaseMessage(reply);
+    var arg = deserialize(serializeDivArgs(7, 3));
+    assert.notStrictEqual(arg, reply);
+    assert(arg instanceof math.DivArgs);
+  });
+  it('should pool at most MAX_POOLED_MESSAGES messages per type', function() {
+    var released = [];
+    var i;
+    for (i = 0; i < 70; i++) {
+      released.push(new math.DivArgs());
+      math_pooled.releaseMessage(released[i]);
+    }
+    var buffer = serializeDivArgs(7, 3);
+    var reused = 0;
+    for (i = 0; i < 70; i++) {
+      if (released.indexOf(deserialize(buffer)) >= 0) {
+        reused++;
+      }
+    }
+    assert.strictEqual(reused, 64);
+  });
+  describe('deserializeInto', function() {
+    it('should replace the contents of the target', function() {
+      var target = new math.DivArgs();
+      target.setDividend(7);
+      var result = math_pooled.deserializeInto(target,
+                                               serializeDivArgs(0, 5));
+      assert.strictEqual(result, target);
+      assert.strictEqual(target.getDividend(), 0);
+      assert.strictEqual(target.getDivisor(), 5);
+    });
+    it('should reject a target of an unknown type', function() {
+      assert.throws(function() {
+        math_pooled.deserializeInto({}, serializeDivArgs(7, 3));
+      }, /Unexpected message type/);
+    });
+  });
+});
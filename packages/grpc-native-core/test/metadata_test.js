@@ -61,6 +61,20 @@ describe('Metadata', function() {
       metadata.set('key', 'value');
       assert.deepEqual(metadata.get('key'), ['value']);
     });
+    it('Checks long keys and values', function() {
+      var long_value = new Array(1000).join('v');
+      metadata.set(new Array(1000).join('K'), long_value);
+      assert.deepEqual(metadata.get(new Array(1000).join('k')), [long_value]);
+      assert.throws(function() {
+        metadata.set('key', long_value + '\n');
+      });
+    });
+    it('Accepts ASCII strings stored with two bytes per character', function() {
+      // A slice of a string with a wider character keeps its representation
+      var value = 'value\u0100'.slice(0, 5);
+      metadata.set('key', value);
+      assert.deepEqual(metadata.get('key'), ['value']);
+    });
     it('Overwrites previous values', function() {
       metadata.set('key', 'value1');
       metadata.set('key', 'value2');
@@ -175,4 +189,38 @@ describe('Metadata', function() {
       assert.deepEqual(metadata.get('key'), ['value1']);
     });
   });
+  describe('core representation', function() {
+    it('round-trips values without conversion', function() {
+      metadata.add('key', 'value1');
+      metadata.add('key', 'value2');
+      metadata.set('key-bin', Buffer.from('value'));
+      var copy = Metadata._fromCoreRepresentation(
+          metadata._getCoreRepresentation());
+      assert.deepEqual(copy.get('key'), ['value1', 'value2']);
+      assert.deepEqual(copy.get('key-bin'), [Buffer.from('value')]);
+    });
+    it('does not share values with the original', function() {
+      metadata.set('key', 'value');
+      var copy = Metadata._fromCoreRepresentation(
+          metadata._getCoreRepresentation());
+      copy.set('key', 'copy_value');
+      metadata.remove('key');
+      assert.deepEqual(copy.get('key'), ['copy_value']);
+      assert.deepEqual(metadata.get('key'), []);
+    });
+    it('reads plain objects like the ones received from core', function() {
+      var copy = Metadata._fromCoreRepresentation({
+        metadata: {key: ['value1', 'value2'], 'key-bin': [Buffer.from('value')]},
+        flags: 0
+      });
+      assert.deepEqual(copy.get('key'), ['value1', 'value2']);
+      assert.deepEqual(copy.get('key-bin'), [Buffer.from('value')]);
+    });
+    it('retains flags', function() {
+      metadata.setOptions({idempotentRequest: true});
+      var copy = Metadata._fromCoreRepresentation(
+          metadata._getCoreRepresentation());
+      assert.strictEqual(copy.flags, metadata.flags);
+    });
+  });
 });
@@ -56,6 +56,14 @@ describe('server', function() {
         new grpc.Server({'key' : new Date()});
       });
     });
+    it('should accept a ResourceQuota as grpc.resource_quota', function() {
+      var quota = new grpc.ResourceQuota(1024 * 1024);
+      var server = new grpc.Server({'grpc.resource_quota': quota});
+      server.addHttp2Port('localhost:0',
+                          grpc.ServerCredentials.createInsecure());
+      server.start();
+      server.forceShutdown();
+    });
   });
   describe('addHttp2Port', function() {
     var server;
@@ -133,4 +141,93 @@ describe('server', function() {
       server.forceShutdown();
     });
   });
+  describe('health check', function() {
+    var server;
+    var channel;
+    before(function() {
+      server = new grpc.Server();
+      var port = server.addHttp2Port('localhost:0',
+                                     grpc.ServerCredentials.createInsecure());
+      server.enableHealthCheck();
+      server.setHealthStatus('', 1);
+      server.setHealthStatus('grpc.test.TestService', 2);
+      server.start();
+      channel = new grpc.Channel('localhost:' + port,
+                                 grpc.ChannelCredentials.createInsecure());
+    });
+    after(function() {
+      channel.close();
+      server.forceShutdown();
+    });
+    function check(service, callback) {
+      var call = channel.createCall('/grpc.health.v1.Health/Check', Infinity);
+      var name = Buffer.from(service);
+      // A serialized HealthCheckRequest with the service field set
+      var request = Buffer.concat([Buffer.from([0x0a, name.length]), name]);
+      var batch = {};
+      batch[grpc.opType.SEND_INITIAL_METADATA] = {metadata: {}};
+      batch[grpc.opType.SEND_MESSAGE] = request;
+      batch[grpc.opType.SEND_CLOSE_FROM_CLIENT] = true;
+      batch[grpc.opType.RECV_INITIAL_METADATA] = true;
+      batch[grpc.opType.RECV_MESSAGE] = true;
+      batch[grpc.opType.RECV_STATUS_ON_CLIENT] = true;
+      call.startBatch(batch, function(err, response) {
+        assert.ifError(err);
+        callback(response.status.code, response.read);
+      });
+    }
+    it('should answer with the status set for the service', function(done) {
+      check('grpc.test.TestService', function(code, response) {
+        assert.strictEqual(code, 0);
+        assert.deepEqual(response, Buffer.from([0x08, 2]));
+        done();
+      });
+    });
+    it('should answer for the server as a whole', function(done) {
+      check('', function(code, response) {
+        assert.strictEqual(code, 0);
+        assert.deepEqual(response, Buffer.from([0x08, 1]));
+        done();
+      });
+    });
+    it('should reply NOT_FOUND for unknown services', function(done) {
+      check('unknown', function(code, response) {
+        assert.strictEqual(code, 5);
+        assert.strictEqual(response, null);
+        done();
+      });
+    });
+    it('should use updated statuses', function(done) {
+      server.setHealthStatus('grpc.test.TestService', 1);
+      check('grpc.test.TestService', function(code, response) {
+        assert.strictEqual(code, 0);
+        assert.deepEqual(response, Buffer.from([0x08, 1]));
+        done();
+      });
+    });
+    it('should not be enabled after the server starts', function() {
+      assert.throws(function() {
+        server.enableHealthCheck();
+      });
+    });
+    it('should survive collecting a server that was shut down', function(done) {
+      if (!global.gc) {
+        // Only meaningful with node --expose-gc
+        this.skip();
+      }
+      var local_server = new grpc.Server();
+      local_server.addHttp2Port('localhost:0',
+                                grpc.ServerCredentials.createInsecure());
+      local_server.enableHealthCheck();
+      local_server.start();
+      local_server.forceShutdown();
+      local_server = null;
+      global.gc();
+      // The pending health check request completes after the collection
+      setTimeout(function() {
+        global.gc();
+        done();
+      }, 100);
+    });
+  });
 });
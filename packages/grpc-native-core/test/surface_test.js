@@ -320,6 +320,64 @@ describe('Echo service', function() {
       done();
     });
   });
+  it('should echo with batch merging on', function(done) {
+    client.echo({value: 'test value', value2: 3}, {merge_batches: true},
+                function(error, response) {
+      assert.ifError(error);
+      assert.deepEqual(response, {value: 'test value', value2: 3});
+      done();
+    });
+  });
+});
+describe('Server batch merging', function() {
+  var server;
+  var client;
+  before(function() {
+    var service = {
+      stream: {
+        path: '/merge/stream',
+        requestStream: false,
+        responseStream: true,
+        requestSerialize: Buffer.from,
+        requestDeserialize: String,
+        responseSerialize: Buffer.from,
+        responseDeserialize: String
+      }
+    };
+    server = new grpc.Server({merge_batches: true});
+    server.addService(service, {
+      stream: function(call) {
+        // The metadata and the first write are started in the same tick
+        call.sendMetadata(new grpc.Metadata());
+        call.write(call.request + '1');
+        call.write(call.request + '2');
+        call.end();
+      }
+    });
+    var port = server.bind('localhost:0', server_insecure_creds);
+    var Client = grpc.makeGenericClientConstructor(service);
+    client = new Client('localhost:' + port, grpc.credentials.createInsecure());
+    server.start();
+  });
+  after(function() {
+    server.forceShutdown();
+  });
+  it('should stream every response', function(done) {
+    done = multiDone(done, 2);
+    var responses = [];
+    var call = client.stream('value');
+    call.on('data', function(response) {
+      responses.push(response);
+    });
+    call.on('end', function() {
+      assert.deepEqual(responses, ['value1', 'value2']);
+      done();
+    });
+    call.on('status', function(status) {
+      assert.strictEqual(status.code, grpc.status.OK);
+      done();
+    });
+  });
 });
 describe('Non-protobuf client and server', function() {
   function toString(val) {
@@ -1219,6 +1277,28 @@ describe('Other conditions', function() {
       peer = call.getPeer();
       assert.strictEqual(typeof peer, 'string');
     });
+    it('when first requested after the call has completed', function(done) {
+      var call = client.unary({error: false}, function(err, data) {
+        assert.ifError(err);
+        setImmediate(function() {
+          assert.notStrictEqual(call.getPeer(), 'unknown');
+          done();
+        });
+      });
+    });
+  });
+});
+describe('fanOut', function() {
+  it('should call back asynchronously with no requests', function(done) {
+    var called = false;
+    var children = grpc.fanOut(null, [], {}, function(err, results) {
+      assert.ifError(err);
+      assert.deepEqual(results, []);
+      called = true;
+      done();
+    });
+    assert.deepEqual(children, []);
+    assert(!called);
   });
 });
 describe('Call propagation', function() {
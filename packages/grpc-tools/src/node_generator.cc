@@ -17,6 +17,10 @@
  */
 
 #include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "config.h"
 #include "generator_helpers.h"
@@ -24,6 +28,7 @@
 #include "node_generator_helpers.h"
 
 using grpc::protobuf::Descriptor;
+using grpc::protobuf::FieldDescriptor;
 using grpc::protobuf::FileDescriptor;
 using grpc::protobuf::MethodDescriptor;
 using grpc::protobuf::ServiceDescriptor;
@@ -112,20 +117,264 @@ grpc::string MessageIdentifierName(const grpc::string& name) {
   return grpc_generator::StringReplace(name, ".", "_");
 }
 
-grpc::string NodeObjectPath(const Descriptor* descriptor) {
+grpc::string NodeObjectPath(const Descriptor* descriptor,
+                            const Parameters& params) {
   grpc::string module_alias = ModuleAlias(descriptor->file()->name());
   grpc::string name = descriptor->full_name();
   grpc_generator::StripPrefix(&name, descriptor->file()->package() + ".");
+  if (params.lazy_load) {
+    // With lazy loading, the module alias is a function that loads the module
+    return module_alias + "()." + name;
+  }
   return module_alias + "." + name;
 }
 
+// Returns the name of the accessor that protoc's JavaScript generator creates
+// for the given singular field. Mirrors JSGetterName in
+// github:google/protobuf/src/google/protobuf/compiler/js/js_generator.cc
+grpc::string JSGetterName(const FieldDescriptor* field) {
+  grpc::string name;
+  bool word_start = true;
+  for (size_t i = 0; i < field->name().size(); i++) {
+    char c = field->name()[i];
+    if (c == '_') {
+      word_start = true;
+      continue;
+    }
+    if (c >= 'A' && c <= 'Z') {
+      c = c - 'A' + 'a';
+    }
+    if (word_start && c >= 'a' && c <= 'z') {
+      c = c - 'a' + 'A';
+    }
+    word_start = false;
+    name += c;
+  }
+  if (name == "Extension" || name == "JsPbMessageInstance") {
+    name += "$";
+  }
+  return "get" + name;
+}
+
+// Returns the number of bytes in the encoded value of a field, or 0 if the
+// encoded size of the field's values can vary
+int FixedValueSize(const FieldDescriptor* field) {
+  switch (field->type()) {
+    case FieldDescriptor::TYPE_DOUBLE:
+      return 8;
+    case FieldDescriptor::TYPE_FLOAT:
+    case FieldDescriptor::TYPE_FIXED32:
+    case FieldDescriptor::TYPE_SFIXED32:
+      return 4;
+    case FieldDescriptor::TYPE_BOOL:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+// Returns the varint encoding of the tag of the given field
+std::vector<int> FieldTagBytes(const FieldDescriptor* field) {
+  uint32_t wire_type;
+  switch (FixedValueSize(field)) {
+    case 8:
+      wire_type = 1;
+      break;
+    case 4:
+      wire_type = 5;
+      break;
+    default:
+      wire_type = 0;
+  }
+  uint32_t tag = (static_cast<uint32_t>(field->number()) << 3) | wire_type;
+  std::vector<int> bytes;
+  while (tag >= 0x80) {
+    bytes.push_back((tag & 0x7f) | 0x80);
+    tag >>= 7;
+  }
+  bytes.push_back(tag);
+  return bytes;
+}
+
+// Returns the maximum encoded size of messages of the given type if it can be
+// computed from the descriptor alone, or -1 otherwise. This is the case for
+// proto3 messages whose fields are all singular fixed-width scalars.
+int FixedMessageSize(const Descriptor* descriptor) {
+  if (descriptor->file()->syntax() != FileDescriptor::SYNTAX_PROTO3 ||
+      descriptor->field_count() == 0) {
+    return -1;
+  }
+  int size = 0;
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (field->is_repeated() || field->containing_oneof() != NULL ||
+        FixedValueSize(field) == 0) {
+      return -1;
+    }
+    size += FieldTagBytes(field).size() + FixedValueSize(field);
+  }
+  return size;
+}
+
+// Prints the body of a serializer that writes each field directly into a
+// buffer of the message's maximum size. Fields with default values are
+// skipped, exactly as in the serializeBinary method of proto3 messages.
+void PrintFixedSizeSerializer(const Descriptor* descriptor, int size,
+                              Printer* out) {
+  map<grpc::string, grpc::string> vars;
+  vars["size"] = std::to_string(size);
+  out->Print(vars, "var buffer = Buffer.allocUnsafe($size$);\n");
+  out->Print("var offset = 0;\n");
+  out->Print("var value;\n");
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* field = descriptor->field(i);
+    vars["getter"] = JSGetterName(field);
+    out->Print(vars, "value = arg.$getter$();\n");
+    if (field->type() == FieldDescriptor::TYPE_BOOL) {
+      out->Print("if (value) {\n");
+    } else {
+      out->Print("if (value !== 0) {\n");
+    }
+    out->Indent();
+    std::vector<int> tag_bytes = FieldTagBytes(field);
+    for (size_t j = 0; j < tag_bytes.size(); j++) {
+      out->Print("buffer[offset++] = $byte$;\n", "byte",
+                 std::to_string(tag_bytes[j]));
+    }
+    switch (field->type()) {
+      case FieldDescriptor::TYPE_DOUBLE:
+        out->Print("buffer.writeDoubleLE(value, offset);\n");
+        out->Print("offset += 8;\n");
+        break;
+      case FieldDescriptor::TYPE_FLOAT:
+        out->Print("buffer.writeFloatLE(value, offset);\n");
+        out->Print("offset += 4;\n");
+        break;
+      case FieldDescriptor::TYPE_FIXED32:
+        out->Print("buffer.writeUInt32LE(value >>> 0, offset);\n");
+        out->Print("offset += 4;\n");
+        break;
+      case FieldDescriptor::TYPE_SFIXED32:
+        out->Print("buffer.writeInt32LE(value | 0, offset);\n");
+        out->Print("offset += 4;\n");
+        break;
+      default:
+        out->Print("buffer[offset++] = 1;\n");
+    }
+    out->Outdent();
+    out->Print("}\n");
+  }
+  out->Print("return buffer.slice(0, offset);\n");
+}
+
+// Prints a deserializer that reuses a message from the pool for its type when
+// one is available, and a deserializeInto function that overwrites an
+// existing message with the contents of a buffer
+void PrintPooledDeserializer(const Descriptor* descriptor, Printer* out,
+                             const Parameters& params) {
+  map<grpc::string, grpc::string> template_vars;
+  template_vars["identifier_name"] =
+      MessageIdentifierName(descriptor->full_name());
+  template_vars["node_name"] = NodeObjectPath(descriptor, params);
+  out->Print(template_vars, "var pool_$identifier_name$ = [];\n\n");
+
+  out->Print(template_vars,
+             "function deserializeInto_$identifier_name$(target, buffer_arg) "
+             "{\n");
+  out->Indent();
+  // Rerunning the constructor resets the message to its empty state
+  out->Print(template_vars, "$node_name$.call(target);\n");
+  out->Print(
+      "var reader = jspb.BinaryReader.alloc(new Uint8Array(buffer_arg));\n");
+  out->Print(template_vars,
+             "$node_name$.deserializeBinaryFromReader(target, reader);\n");
+  out->Print("reader.free();\n");
+  out->Print("return target;\n");
+  out->Outdent();
+  out->Print("}\n\n");
+
+  out->Print(template_vars,
+             "function deserialize_$identifier_name$(buffer_arg) {\n");
+  out->Indent();
+  out->Print(template_vars, "if (pool_$identifier_name$.length > 0) {\n");
+  out->Indent();
+  out->Print(template_vars,
+             "return deserializeInto_$identifier_name$("
+             "pool_$identifier_name$.pop(), buffer_arg);\n");
+  out->Outdent();
+  out->Print("}\n");
+  out->Print(
+      template_vars,
+      "return $node_name$.deserializeBinary(new Uint8Array(buffer_arg));\n");
+  out->Outdent();
+  out->Print("}\n\n");
+}
+
+// Prints the exported functions that dispatch to the deserializeInto function
+// and the message pool of each message type
+void PrintMessagePoolExports(
+    const map<grpc::string, const Descriptor*>& messages, Printer* out,
+    const Parameters& params) {
+  out->Print("var MAX_POOLED_MESSAGES = 64;\n\n");
+  out->Print(
+      "// Deserializes buffer_arg into target, replacing its previous "
+      "contents\n");
+  out->Print("exports.deserializeInto = function(target, buffer_arg) {\n");
+  out->Indent();
+  for (map<grpc::string, const Descriptor*>::const_iterator it =
+           messages.begin();
+       it != messages.end(); it++) {
+    map<grpc::string, grpc::string> vars;
+    vars["identifier_name"] = MessageIdentifierName(it->first);
+    vars["node_name"] = NodeObjectPath(it->second, params);
+    out->Print(vars, "if (target instanceof $node_name$) {\n");
+    out->Indent();
+    out->Print(vars,
+               "return deserializeInto_$identifier_name$(target, "
+               "buffer_arg);\n");
+    out->Outdent();
+    out->Print("}\n");
+  }
+  out->Print("throw new Error('Unexpected message type');\n");
+  out->Outdent();
+  out->Print("};\n\n");
+
+  out->Print(
+      "// Returns a message that is no longer used to the pool for its type,\n"
+      "// so that a later deserialize call can reuse it. The message must not\n"
+      "// be accessed after it has been released.\n");
+  out->Print("exports.releaseMessage = function(message) {\n");
+  out->Indent();
+  for (map<grpc::string, const Descriptor*>::const_iterator it =
+           messages.begin();
+       it != messages.end(); it++) {
+    map<grpc::string, grpc::string> vars;
+    vars["identifier_name"] = MessageIdentifierName(it->first);
+    vars["node_name"] = NodeObjectPath(it->second, params);
+    out->Print(vars, "if (message instanceof $node_name$) {\n");
+    out->Indent();
+    out->Print(vars,
+               "if (pool_$identifier_name$.length < MAX_POOLED_MESSAGES) {\n");
+    out->Indent();
+    out->Print(vars, "pool_$identifier_name$.push(message);\n");
+    out->Outdent();
+    out->Print("}\n");
+    out->Print("return;\n");
+    out->Outdent();
+    out->Print("}\n");
+  }
+  out->Outdent();
+  out->Print("};\n\n");
+}
+
 // Prints out the message serializer and deserializer functions
-void PrintMessageTransformer(const Descriptor* descriptor, Printer* out) {
+void PrintMessageTransformer(const Descriptor* descriptor, Printer* out,
+                             const Parameters& params) {
   map<grpc::string, grpc::string> template_vars;
   grpc::string full_name = descriptor->full_name();
   template_vars["identifier_name"] = MessageIdentifierName(full_name);
   template_vars["name"] = full_name;
-  template_vars["node_name"] = NodeObjectPath(descriptor);
+  template_vars["node_name"] = NodeObjectPath(descriptor, params);
   // Print the serializer
   out->Print(template_vars, "function serialize_$identifier_name$(arg) {\n");
   out->Indent();
@@ -135,10 +384,20 @@ void PrintMessageTransformer(const Descriptor* descriptor, Printer* out) {
              "throw new Error('Expected argument of type $name$');\n");
   out->Outdent();
   out->Print("}\n");
-  out->Print("return Buffer.from(arg.serializeBinary());\n");
+  int fixed_size = params.size_hints ? FixedMessageSize(descriptor) : -1;
+  if (fixed_size >= 0) {
+    PrintFixedSizeSerializer(descriptor, fixed_size, out);
+  } else {
+    out->Print("return Buffer.from(arg.serializeBinary());\n");
+  }
   out->Outdent();
   out->Print("}\n\n");
 
+  if (params.message_pools) {
+    PrintPooledDeserializer(descriptor, out, params);
+    return;
+  }
+
   // Print the deserializer
   out->Print(template_vars,
              "function deserialize_$identifier_name$(buffer_arg) {\n");
@@ -150,15 +409,16 @@ void PrintMessageTransformer(const Descriptor* descriptor, Printer* out) {
   out->Print("}\n\n");
 }
 
-void PrintMethod(const MethodDescriptor* method, Printer* out) {
+void PrintMethod(const MethodDescriptor* method, Printer* out,
+                 const Parameters& params) {
   const Descriptor* input_type = method->input_type();
   const Descriptor* output_type = method->output_type();
   map<grpc::string, grpc::string> vars;
   vars["service_name"] = method->service()->full_name();
   vars["name"] = method->name();
-  vars["input_type"] = NodeObjectPath(input_type);
+  vars["input_type"] = NodeObjectPath(input_type, params);
   vars["input_type_id"] = MessageIdentifierName(input_type->full_name());
-  vars["output_type"] = NodeObjectPath(output_type);
+  vars["output_type"] = NodeObjectPath(output_type, params);
   vars["output_type_id"] = MessageIdentifierName(output_type->full_name());
   vars["client_stream"] = method->client_streaming() ? "true" : "false";
   vars["server_stream"] = method->server_streaming() ? "true" : "false";
@@ -167,8 +427,10 @@ void PrintMethod(const MethodDescriptor* method, Printer* out) {
   out->Print(vars, "path: '/$service_name$/$name$',\n");
   out->Print(vars, "requestStream: $client_stream$,\n");
   out->Print(vars, "responseStream: $server_stream$,\n");
-  out->Print(vars, "requestType: $input_type$,\n");
-  out->Print(vars, "responseType: $output_type$,\n");
+  if (!params.lazy_load) {
+    out->Print(vars, "requestType: $input_type$,\n");
+    out->Print(vars, "responseType: $output_type$,\n");
+  }
   out->Print(vars, "requestSerialize: serialize_$input_type_id$,\n");
   out->Print(vars, "requestDeserialize: deserialize_$input_type_id$,\n");
   out->Print(vars, "responseSerialize: serialize_$output_type_id$,\n");
@@ -177,8 +439,39 @@ void PrintMethod(const MethodDescriptor* method, Printer* out) {
   out->Print("}");
 }
 
+// Prints getters for the request and response types of each method. They are
+// not enumerable, so copying a method definition (as client constructors do)
+// does not load the message modules.
+void PrintLazyMessageTypes(const ServiceDescriptor* service, Printer* out,
+                           const Parameters& params) {
+  for (int i = 0; i < service->method_count(); i++) {
+    const MethodDescriptor* method = service->method(i);
+    map<grpc::string, grpc::string> vars;
+    vars["service"] = service->name() + "Service";
+    vars["method_name"] = grpc_generator::LowercaseFirstLetter(method->name());
+    vars["input_type"] = NodeObjectPath(method->input_type(), params);
+    vars["output_type"] = NodeObjectPath(method->output_type(), params);
+    out->Print(vars,
+               "defineLazyMessageType($service$.$method_name$, "
+               "'requestType', function() {\n");
+    out->Indent();
+    out->Print(vars, "return $input_type$;\n");
+    out->Outdent();
+    out->Print("});\n");
+    out->Print(vars,
+               "defineLazyMessageType($service$.$method_name$, "
+               "'responseType', function() {\n");
+    out->Indent();
+    out->Print(vars, "return $output_type$;\n");
+    out->Outdent();
+    out->Print("});\n");
+  }
+  out->Print("\n");
+}
+
 // Prints out the service descriptor object
-void PrintService(const ServiceDescriptor* service, Printer* out) {
+void PrintService(const ServiceDescriptor* service, Printer* out,
+                  const Parameters& params) {
   map<grpc::string, grpc::string> template_vars;
   out->Print(GetNodeComments(service, true).c_str());
   template_vars["name"] = service->name();
@@ -189,55 +482,157 @@ void PrintService(const ServiceDescriptor* service, Printer* out) {
         grpc_generator::LowercaseFirstLetter(service->method(i)->name());
     out->Print(GetNodeComments(service->method(i), true).c_str());
     out->Print("$method_name$: ", "method_name", method_name);
-    PrintMethod(service->method(i), out);
+    PrintMethod(service->method(i), out, params);
     out->Print(",\n");
     out->Print(GetNodeComments(service->method(i), false).c_str());
   }
   out->Outdent();
   out->Print("};\n\n");
+  if (params.lazy_load) {
+    PrintLazyMessageTypes(service, out, params);
+  }
   out->Print(template_vars,
              "exports.$name$Client = "
              "grpc.makeGenericClientConstructor($name$Service);\n");
   out->Print(GetNodeComments(service, false).c_str());
 }
 
-void PrintImports(const FileDescriptor* file, Printer* out) {
-  out->Print("var grpc = require('grpc');\n");
-  if (file->message_type_count() > 0) {
-    grpc::string file_path =
-        GetRelativePath(file->name(), GetJSMessageFilename(file->name()));
-    out->Print("var $module_alias$ = require('$file_path$');\n", "module_alias",
-               ModuleAlias(file->name()), "file_path", file_path);
+// Prints a function that loads the module at file_path the first time it is
+// called, and returns the loaded module on every call
+void PrintLazyImport(const grpc::string& module_alias,
+                     const grpc::string& file_path, Printer* out) {
+  map<grpc::string, grpc::string> vars;
+  vars["module_alias"] = module_alias;
+  vars["file_path"] = file_path;
+  out->Print(vars, "var $module_alias$_module;\n");
+  out->Print(vars, "function $module_alias$() {\n");
+  out->Indent();
+  out->Print(vars, "if ($module_alias$_module === undefined) {\n");
+  out->Indent();
+  out->Print(vars, "$module_alias$_module = require('$file_path$');\n");
+  out->Outdent();
+  out->Print("}\n");
+  out->Print(vars, "return $module_alias$_module;\n");
+  out->Outdent();
+  out->Print("}\n");
+}
+
+void PrintImport(const grpc::string& module_alias,
+                 const grpc::string& file_path, Printer* out,
+                 const Parameters& params) {
+  if (params.lazy_load) {
+    PrintLazyImport(module_alias, file_path, out);
+  } else {
+    out->Print("var $module_alias$ = require('$file_path$');\n",
+               "module_alias", module_alias, "file_path", file_path);
+  }
+}
+
+// Adds the message module of the given file to imports, unless a module with
+// the same alias has already been added
+void AddImport(const grpc::string& from_filename,
+               const FileDescriptor* imported_file,
+               std::vector<std::pair<grpc::string, grpc::string>>* imports,
+               std::set<grpc::string>* aliases) {
+  grpc::string module_alias = ModuleAlias(imported_file->name());
+  if (!aliases->insert(module_alias).second) {
+    return;
   }
+  grpc::string file_path = GetRelativePath(
+      from_filename, GetJSMessageFilename(imported_file->name()));
+  imports->push_back(std::make_pair(module_alias, file_path));
+}
 
-  for (int i = 0; i < file->dependency_count(); i++) {
-    grpc::string file_path = GetRelativePath(
-        file->name(), GetJSMessageFilename(file->dependency(i)->name()));
-    out->Print("var $module_alias$ = require('$file_path$');\n", "module_alias",
-               ModuleAlias(file->dependency(i)->name()), "file_path",
-               file_path);
+// Prints the imports needed by the services in files, in a module named
+// from_filename. Each message module is imported once.
+void PrintImports(const std::vector<const FileDescriptor*>& files,
+                  const grpc::string& from_filename, Printer* out,
+                  const Parameters& params) {
+  out->Print("var grpc = require('grpc');\n");
+  if (params.message_pools) {
+    out->Print("var jspb = require('google-protobuf');\n");
+  }
+  std::vector<std::pair<grpc::string, grpc::string>> imports;
+  std::set<grpc::string> aliases;
+  for (size_t i = 0; i < files.size(); i++) {
+    const FileDescriptor* file = files[i];
+    if (file->message_type_count() > 0) {
+      AddImport(from_filename, file, &imports, &aliases);
+    }
+    for (int j = 0; j < file->dependency_count(); j++) {
+      AddImport(from_filename, file->dependency(j), &imports, &aliases);
+    }
+  }
+  for (size_t i = 0; i < imports.size(); i++) {
+    PrintImport(imports[i].first, imports[i].second, out, params);
   }
   out->Print("\n");
+  if (params.lazy_load) {
+    out->Print(
+        "function defineLazyMessageType(method, property, getType) {\n");
+    out->Indent();
+    out->Print("Object.defineProperty(method, property, {get: getType});\n");
+    out->Outdent();
+    out->Print("}\n\n");
+  }
 }
 
-void PrintTransformers(const FileDescriptor* file, Printer* out) {
-  map<grpc::string, const Descriptor*> messages = GetAllMessages(file);
+void PrintTransformers(const std::vector<const FileDescriptor*>& files,
+                       Printer* out, const Parameters& params) {
+  map<grpc::string, const Descriptor*> messages;
+  for (size_t i = 0; i < files.size(); i++) {
+    map<grpc::string, const Descriptor*> file_messages =
+        GetAllMessages(files[i]);
+    messages.insert(file_messages.begin(), file_messages.end());
+  }
   for (std::map<grpc::string, const Descriptor*>::iterator it =
            messages.begin();
        it != messages.end(); it++) {
-    PrintMessageTransformer(it->second, out);
+    PrintMessageTransformer(it->second, out, params);
+  }
+  // A file whose services have no methods has no messages to pool
+  if (params.message_pools && !messages.empty()) {
+    PrintMessagePoolExports(messages, out, params);
   }
   out->Print("\n");
 }
 
-void PrintServices(const FileDescriptor* file, Printer* out) {
+void PrintServices(const FileDescriptor* file, Printer* out,
+                   const Parameters& params) {
   for (int i = 0; i < file->service_count(); i++) {
-    PrintService(file->service(i), out);
+    PrintService(file->service(i), out, params);
   }
 }
 }  // namespace
 
-grpc::string GenerateFile(const FileDescriptor* file) {
+bool ParseParameters(const grpc::string& parameter, Parameters* params,
+                     grpc::string* error) {
+  if (parameter.empty()) {
+    return true;
+  }
+  std::vector<grpc::string> parameters_list =
+      grpc_generator::tokenize(parameter, ",");
+  for (auto parameter_string = parameters_list.begin();
+       parameter_string != parameters_list.end(); parameter_string++) {
+    if (*parameter_string == "lazy_load") {
+      params->lazy_load = true;
+    } else if (*parameter_string == "size_hints") {
+      params->size_hints = true;
+    } else if (*parameter_string == "message_pools") {
+      params->message_pools = true;
+    } else if (parameter_string->compare(0, 7, "bundle=") == 0 &&
+               parameter_string->size() > 7) {
+      params->bundle = parameter_string->substr(7);
+    } else {
+      *error = grpc::string("Unknown parameter: ") + *parameter_string;
+      return false;
+    }
+  }
+  return true;
+}
+
+grpc::string GenerateFile(const FileDescriptor* file,
+                          const Parameters& params) {
   grpc::string output;
   {
     StringOutputStream output_stream(&output);
@@ -257,15 +652,63 @@ grpc::string GenerateFile(const FileDescriptor* file) {
 
     out.Print("'use strict';\n");
 
-    PrintImports(file, &out);
+    std::vector<const FileDescriptor*> files(1, file);
+
+    PrintImports(files, file->name(), &out, params);
 
-    PrintTransformers(file, &out);
+    PrintTransformers(files, &out, params);
 
-    PrintServices(file, &out);
+    PrintServices(file, &out, params);
 
     out.Print(GetNodeComments(file, false).c_str());
   }
   return output;
 }
 
+bool GenerateBundle(const std::vector<const FileDescriptor*>& files,
+                    const Parameters& params, grpc::string* output,
+                    grpc::string* error) {
+  std::vector<const FileDescriptor*> service_files;
+  map<grpc::string, const FileDescriptor*> service_names;
+  for (size_t i = 0; i < files.size(); i++) {
+    const FileDescriptor* file = files[i];
+    for (int j = 0; j < file->service_count(); j++) {
+      // Services are exported by their unqualified names
+      const grpc::string& name = file->service(j)->name();
+      if (service_names.count(name) > 0) {
+        *error = "Service " + name + " is defined in both " +
+                 service_names[name]->name() + " and " + file->name() +
+                 ", so they cannot be bundled into the same module";
+        return false;
+      }
+      service_names[name] = file;
+    }
+    if (file->service_count() > 0) {
+      service_files.push_back(file);
+    }
+  }
+
+  StringOutputStream output_stream(output);
+  Printer out(&output_stream, '$');
+
+  if (service_files.empty()) {
+    out.Print("// GENERATED CODE -- NO SERVICES IN PROTO");
+    return true;
+  }
+  out.Print("// GENERATED CODE -- DO NOT EDIT!\n\n");
+  out.Print("'use strict';\n");
+
+  PrintImports(service_files, GetJSServiceBundleFilename(params.bundle), &out,
+               params);
+
+  PrintTransformers(service_files, &out, params);
+
+  for (size_t i = 0; i < service_files.size(); i++) {
+    out.Print("// Services from $file$\n", "file", service_files[i]->name());
+    PrintServices(service_files[i], &out, params);
+    out.Print("\n");
+  }
+  return true;
+}
+
 }  // namespace grpc_node_generator
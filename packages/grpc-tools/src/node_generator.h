@@ -19,11 +19,42 @@
 #ifndef GRPC_INTERNAL_COMPILER_NODE_GENERATOR_H
 #define GRPC_INTERNAL_COMPILER_NODE_GENERATOR_H
 
+#include <vector>
+
 #include "config.h"
 
 namespace grpc_node_generator {
 
-grpc::string GenerateFile(const grpc::protobuf::FileDescriptor* file);
+struct Parameters {
+  // Load message modules on first use instead of when the generated module
+  // is loaded.
+  bool lazy_load;
+  // Serialize messages with a fixed maximum encoded size directly into a
+  // buffer of that size.
+  bool size_hints;
+  // Reuse message objects released by handlers when deserializing.
+  bool message_pools;
+  // If not empty, the services of every file in the protoc invocation are
+  // generated into a single module with this name.
+  grpc::string bundle;
+
+  Parameters() : lazy_load(false), size_hints(false), message_pools(false) {}
+};
+
+// Parses a comma-separated plugin parameter string into params. Returns false
+// and sets error if it contains an unknown parameter.
+bool ParseParameters(const grpc::string& parameter, Parameters* params,
+                     grpc::string* error);
+
+grpc::string GenerateFile(const grpc::protobuf::FileDescriptor* file,
+                          const Parameters& params);
+
+// Generates the module named by params.bundle, which contains the services of
+// all of the given files. Returns false and sets error if two of the services
+// would be exported with the same name.
+bool GenerateBundle(
+    const std::vector<const grpc::protobuf::FileDescriptor*>& files,
+    const Parameters& params, grpc::string* output, grpc::string* error);
 
 }  // namespace grpc_node_generator
 
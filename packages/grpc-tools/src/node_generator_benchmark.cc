@@ -0,0 +1,268 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Measures the throughput and output size of the Node service generator.
+//
+// Usage: grpc_node_plugin_benchmark [options] [descriptor_set_file]
+//   --services=N     Number of services in the synthetic file (default 1000)
+//   --methods=N      Number of methods per service (default 10)
+//   --messages=N     Number of message types in the synthetic file
+//                    (default 500)
+//   --iterations=N   Number of times each file is generated (default 10)
+//   --parameter=P    Generator parameter, as passed to the plugin. With
+//                    bundle=NAME, each iteration generates one bundle of
+//                    every file, as GenerateAll in the plugin does.
+//
+// If descriptor_set_file is given, it must be a FileDescriptorSet, as written
+// by protoc --include_imports --descriptor_set_out, and every file in it that
+// has services is generated instead of the synthetic file.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#include "config.h"
+#include "node_generator.h"
+
+using grpc::protobuf::DescriptorPool;
+using grpc::protobuf::FileDescriptor;
+using grpc::protobuf::FileDescriptorProto;
+using google::protobuf::DescriptorProto;
+using google::protobuf::FieldDescriptorProto;
+using google::protobuf::FileDescriptorSet;
+using google::protobuf::MethodDescriptorProto;
+using google::protobuf::ServiceDescriptorProto;
+using google::protobuf::SourceCodeInfo;
+
+namespace {
+
+struct Options {
+  int services;
+  int methods;
+  int messages;
+  int iterations;
+  grpc::string parameter;
+  grpc::string descriptor_set_file;
+
+  Options()
+      : services(1000), methods(10), messages(500), iterations(10) {}
+};
+
+bool ParseIntFlag(const grpc::string& arg, const grpc::string& name,
+                  int* value) {
+  grpc::string prefix = "--" + name + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  *value = atoi(arg.c_str() + prefix.size());
+  return true;
+}
+
+bool ParseOptions(int argc, char* argv[], Options* options) {
+  for (int i = 1; i < argc; i++) {
+    grpc::string arg = argv[i];
+    if (ParseIntFlag(arg, "services", &options->services) ||
+        ParseIntFlag(arg, "methods", &options->methods) ||
+        ParseIntFlag(arg, "messages", &options->messages) ||
+        ParseIntFlag(arg, "iterations", &options->iterations)) {
+      continue;
+    }
+    if (arg.compare(0, 12, "--parameter=") == 0) {
+      options->parameter = arg.substr(12);
+    } else if (arg.compare(0, 2, "--") != 0 &&
+               options->descriptor_set_file.empty()) {
+      options->descriptor_set_file = arg;
+    } else {
+      fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+      return false;
+    }
+  }
+  return options->services > 0 && options->methods > 0 &&
+         options->messages > 0 && options->iterations > 0;
+}
+
+void AddComment(SourceCodeInfo* info, const std::vector<int>& path,
+                const grpc::string& comment) {
+  SourceCodeInfo::Location* location = info->add_location();
+  for (size_t i = 0; i < path.size(); i++) {
+    location->add_path(path[i]);
+  }
+  // Spans are required, but the generator does not use them
+  location->add_span(0);
+  location->add_span(0);
+  location->add_span(0);
+  location->set_leading_comments(comment);
+}
+
+// Builds a file that imports a shared messages file and defines the
+// requested number of message types and services, with comments on every
+// service and method.
+std::vector<FileDescriptorProto> BuildSyntheticFiles(const Options& options) {
+  FileDescriptorProto common;
+  common.set_name("bench/common.proto");
+  common.set_package("bench.common");
+  common.set_syntax("proto3");
+  DescriptorProto* empty = common.add_message_type();
+  empty->set_name("Empty");
+
+  FileDescriptorProto file;
+  file.set_name("bench/services.proto");
+  file.set_package("bench");
+  file.set_syntax("proto3");
+  file.add_dependency(common.name());
+  for (int i = 0; i < options.messages; i++) {
+    DescriptorProto* message = file.add_message_type();
+    message->set_name("Message" + std::to_string(i));
+    FieldDescriptorProto* id = message->add_field();
+    id->set_name("id");
+    id->set_number(1);
+    id->set_label(FieldDescriptorProto::LABEL_OPTIONAL);
+    id->set_type(FieldDescriptorProto::TYPE_FIXED32);
+    FieldDescriptorProto* name = message->add_field();
+    name->set_name("name");
+    name->set_number(2);
+    name->set_label(FieldDescriptorProto::LABEL_OPTIONAL);
+    name->set_type(FieldDescriptorProto::TYPE_STRING);
+  }
+  SourceCodeInfo* info = file.mutable_source_code_info();
+  for (int i = 0; i < options.services; i++) {
+    ServiceDescriptorProto* service = file.add_service();
+    service->set_name("Service" + std::to_string(i));
+    // 6 is the field number of FileDescriptorProto.service
+    AddComment(info, {6, i}, " Synthetic service number " +
+                                 std::to_string(i) + "\n");
+    for (int j = 0; j < options.methods; j++) {
+      MethodDescriptorProto* method = service->add_method();
+      int message_index = (i * options.methods + j) % options.messages;
+      method->set_name("Method" + std::to_string(j));
+      method->set_input_type(".bench.Message" +
+                             std::to_string(message_index));
+      if (j % 5 == 4) {
+        method->set_output_type(".bench.common.Empty");
+      } else {
+        method->set_output_type(
+            ".bench.Message" +
+            std::to_string((message_index + 1) % options.messages));
+      }
+      method->set_client_streaming(j % 4 == 1 || j % 4 == 3);
+      method->set_server_streaming(j % 4 == 2 || j % 4 == 3);
+      // 2 is the field number of ServiceDescriptorProto.method
+      AddComment(info, {6, i, 2, j},
+                 " Synthetic method number " + std::to_string(j) +
+                     "\n Sends a message and receives a response\n");
+    }
+  }
+  return {common, file};
+}
+
+bool LoadDescriptorSet(const grpc::string& path,
+                       std::vector<FileDescriptorProto>* files) {
+  std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+  FileDescriptorSet descriptor_set;
+  if (!input || !descriptor_set.ParseFromIstream(&input)) {
+    fprintf(stderr, "Failed to read a FileDescriptorSet from %s\n",
+            path.c_str());
+    return false;
+  }
+  for (int i = 0; i < descriptor_set.file_size(); i++) {
+    files->push_back(descriptor_set.file(i));
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "Usage: %s [--services=N] [--methods=N] [--messages=N] "
+            "[--iterations=N] [--parameter=P] [descriptor_set_file]\n",
+            argv[0]);
+    return 1;
+  }
+  grpc_node_generator::Parameters params;
+  grpc::string error;
+  if (!grpc_node_generator::ParseParameters(options.parameter, &params,
+                                            &error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+
+  std::vector<FileDescriptorProto> file_protos;
+  if (options.descriptor_set_file.empty()) {
+    file_protos = BuildSyntheticFiles(options);
+  } else if (!LoadDescriptorSet(options.descriptor_set_file, &file_protos)) {
+    return 1;
+  }
+
+  DescriptorPool pool;
+  std::vector<const FileDescriptor*> files;
+  int service_count = 0;
+  int method_count = 0;
+  for (size_t i = 0; i < file_protos.size(); i++) {
+    const FileDescriptor* file = pool.BuildFile(file_protos[i]);
+    if (file == NULL) {
+      fprintf(stderr, "Failed to build %s\n", file_protos[i].name().c_str());
+      return 1;
+    }
+    if (file->service_count() == 0) {
+      continue;
+    }
+    files.push_back(file);
+    service_count += file->service_count();
+    for (int j = 0; j < file->service_count(); j++) {
+      method_count += file->service(j)->method_count();
+    }
+  }
+
+  size_t output_bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < options.iterations; i++) {
+    if (!params.bundle.empty()) {
+      grpc::string output;
+      if (!grpc_node_generator::GenerateBundle(files, params, &output,
+                                               &error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+      }
+      output_bytes += output.size();
+      continue;
+    }
+    for (size_t j = 0; j < files.size(); j++) {
+      output_bytes +=
+          grpc_node_generator::GenerateFile(files[j], params).size();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  double bytes_per_iteration =
+      static_cast<double>(output_bytes) / options.iterations;
+  printf("files: %zu, services: %d, methods: %d, iterations: %d\n",
+         files.size(), service_count, method_count, options.iterations);
+  printf("generation time: %.3f ms per iteration\n",
+         seconds * 1000 / options.iterations);
+  printf("output size: %.0f bytes per iteration\n", bytes_per_iteration);
+  printf("throughput: %.0f methods/s, %.2f MB/s\n",
+         method_count * options.iterations / seconds,
+         output_bytes / seconds / (1024 * 1024));
+  return 0;
+}
@@ -30,6 +30,10 @@ inline grpc::string GetJSServiceFilename(const grpc::string& filename) {
   return grpc_generator::StripProto(filename) + "_grpc_pb.js";
 }
 
+inline grpc::string GetJSServiceBundleFilename(const grpc::string& bundle) {
+  return bundle + "_grpc_pb.js";
+}
+
 // Get leading or trailing comments in a string. Comment lines start with "// ".
 // Leading detached comments are put in in front of leading comments.
 template <typename DescriptorType>
@@ -19,13 +19,18 @@
 // Generates Node gRPC service interface out of Protobuf IDL.
 
 #include <memory>
+#include <vector>
 
 #include "config.h"
 #include "node_generator.h"
 #include "node_generator_helpers.h"
 
+using grpc_node_generator::GenerateBundle;
 using grpc_node_generator::GenerateFile;
+using grpc_node_generator::GetJSServiceBundleFilename;
 using grpc_node_generator::GetJSServiceFilename;
+using grpc_node_generator::Parameters;
+using grpc_node_generator::ParseParameters;
 
 class NodeGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
  public:
@@ -36,8 +41,12 @@ class NodeGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
                 const grpc::string& parameter,
                 grpc::protobuf::compiler::GeneratorContext* context,
                 grpc::string* error) const {
+    Parameters generator_parameters;
+    if (!ParseParameters(parameter, &generator_parameters, error)) {
+      return false;
+    }
 
-    grpc::string code = GenerateFile(file);
+    grpc::string code = GenerateFile(file, generator_parameters);
     if (code.size() == 0) {
       return true;
     }
@@ -45,11 +54,40 @@ class NodeGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
     // Get output file name
     grpc::string file_name = GetJSServiceFilename(file->name());
 
+    WriteFile(file_name, code, context);
+    return true;
+  }
+
+  bool GenerateAll(
+      const std::vector<const grpc::protobuf::FileDescriptor*>& files,
+      const grpc::string& parameter,
+      grpc::protobuf::compiler::GeneratorContext* context,
+      grpc::string* error) const {
+    Parameters generator_parameters;
+    if (!ParseParameters(parameter, &generator_parameters, error)) {
+      return false;
+    }
+    if (generator_parameters.bundle.empty()) {
+      return grpc::protobuf::compiler::CodeGenerator::GenerateAll(
+          files, parameter, context, error);
+    }
+
+    grpc::string code;
+    if (!GenerateBundle(files, generator_parameters, &code, error)) {
+      return false;
+    }
+    WriteFile(GetJSServiceBundleFilename(generator_parameters.bundle), code,
+              context);
+    return true;
+  }
+
+ private:
+  void WriteFile(const grpc::string& file_name, const grpc::string& code,
+                 grpc::protobuf::compiler::GeneratorContext* context) const {
     std::unique_ptr<grpc::protobuf::io::ZeroCopyOutputStream> output(
         context->Open(file_name));
     grpc::protobuf::io::CodedOutputStream coded_out(output.get());
     coded_out.WriteRaw(code.data(), code.size());
-    return true;
   }
 };
 
@@ -0,0 +1,118 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Compares unary latency and CPU use with busy polling off and with a few
+ * CPU budgets. Requests are sent one at a time with a pause between them,
+ * like a lightly loaded latency-sensitive service, which is where the loop
+ * would otherwise sleep between requests. Pass --server=ADDRESS to call a
+ * server in another process, which shows the client side on its own.
+ *
+ * Usage: node busy_poll_benchmark.js [--requests=N] [--interval=MS]
+ *     [--budgets=0,0.25,1] [--server=ADDRESS]
+ * @module
+ */
+
+'use strict';
+
+var _ = require('lodash');
+var minimist = require('minimist');
+
+var grpc = require('../../packages/grpc-native-core');
+var genericService = require('./generic_service');
+var Histogram = require('./histogram');
+
+var argv = minimist(process.argv.slice(2), {
+  string: ['budgets', 'server'],
+  default: {requests: 2000, interval: 1, budgets: '0,0.25,1'}
+});
+
+var GenericClient = grpc.makeGenericClientConstructor(genericService);
+
+function startServer() {
+  var server = new grpc.Server();
+  server.addService(genericService, {
+    unaryCall: function(call, callback) {
+      callback(null, call.request);
+    },
+    streamingCall: function(call) {
+      call.end();
+    }
+  });
+  var port = server.bind('localhost:0',
+                         grpc.ServerCredentials.createInsecure());
+  server.start();
+  return {server: server, address: 'localhost:' + port};
+}
+
+function runBudget(client, budget, callback) {
+  grpc.setBusyPolling(budget);
+  var histogram = new Histogram(0.01, 60e9);
+  var payload = Buffer.alloc(16);
+  var remaining = argv.requests;
+  var startCpu = process.cpuUsage();
+  var startTime = process.hrtime();
+  function next() {
+    var requestStart = process.hrtime();
+    client.unaryCall(payload, function(err) {
+      if (err) {
+        throw err;
+      }
+      var elapsed = process.hrtime(requestStart);
+      histogram.add(elapsed[0] * 1e9 + elapsed[1]);
+      remaining--;
+      if (remaining > 0) {
+        setTimeout(next, argv.interval);
+        return;
+      }
+      var time = process.hrtime(startTime);
+      var cpu = process.cpuUsage(startCpu);
+      var wallUs = time[0] * 1e6 + time[1] / 1e3;
+      console.log('budget ' + _.padEnd(budget, 6) +
+                  '  mean ' + (histogram.mean() / 1000).toFixed(1) + 'us' +
+                  '  stddev ' + (histogram.stddev() / 1000).toFixed(1) + 'us' +
+                  '  cpu ' + ((cpu.user + cpu.system) / wallUs * 100)
+                      .toFixed(0) + '%');
+      callback();
+    });
+  }
+  next();
+}
+
+var local = argv.server ? null : startServer();
+var client = new GenericClient(argv.server || local.address,
+                               grpc.credentials.createInsecure());
+var budgets = argv.budgets.split(',').map(Number);
+
+// Run an unmeasured round first, so that the first budget is not penalized
+// for connecting and warming up the JIT
+runBudget(client, 0, function() {
+  console.log('(warmup)');
+  var index = 0;
+  (function nextBudget() {
+    if (index === budgets.length) {
+      grpc.setBusyPolling(0);
+      client.close();
+      if (local) {
+        local.server.forceShutdown();
+      }
+      return;
+    }
+    runBudget(client, budgets[index++], nextBudget);
+  })();
+});
@@ -0,0 +1,93 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Compares arming and clearing one timer per call deadline with the shared
+ * deadline wheel that grpc-js uses. Each round starts --calls deadlines a few
+ * seconds out, then completes all of them, as happens to the deadlines of
+ * calls that finish in time. Requires grpc-js to be built.
+ *
+ * Usage: node deadline_wheel_benchmark.js [--calls=N] [--rounds=N]
+ * @module
+ */
+
+'use strict';
+
+var _ = require('lodash');
+var minimist = require('minimist');
+
+var DeadlineWheel =
+    require('../../packages/grpc-js/build/src/deadline-wheel').DeadlineWheel;
+
+var argv = minimist(process.argv.slice(2), {
+  default: {calls: 100000, rounds: 10}
+});
+
+var timersArmed = 0;
+var realSetTimeout = global.setTimeout;
+global.setTimeout = function() {
+  timersArmed++;
+  return realSetTimeout.apply(this, arguments);
+};
+
+function noop() {}
+
+var strategies = {
+  timers: function(deadlines) {
+    var now = Date.now();
+    var timers = deadlines.map(function(deadline) {
+      return setTimeout(noop, deadline - now);
+    });
+    timers.forEach(clearTimeout);
+  },
+  wheel: function(deadlines) {
+    var wheel = new DeadlineWheel();
+    var entries = deadlines.map(function(deadline) {
+      return wheel.add(deadline, noop);
+    });
+    entries.forEach(function(entry) {
+      wheel.remove(entry);
+    });
+  }
+};
+
+function run(name) {
+  var elapsed = 0;
+  timersArmed = 0;
+  for (var round = 0; round < argv.rounds; round++) {
+    var now = Date.now();
+    var deadlines = _.times(argv.calls, function() {
+      return now + 5000 + Math.random() * 1000;
+    });
+    var start = process.hrtime();
+    strategies[name](deadlines);
+    var time = process.hrtime(start);
+    elapsed += time[0] * 1e9 + time[1];
+  }
+  console.log(_.padEnd(name, 8) +
+              _.padStart((elapsed / (argv.calls * argv.rounds)).toFixed(0), 6) +
+              ' ns/call  ' +
+              _.padStart((timersArmed / argv.rounds).toFixed(0), 8) +
+              ' timers armed per round');
+}
+
+// Run each strategy twice, so that the first runs warm up the JIT
+run('timers');
+run('wheel');
+run('timers');
+run('wheel');
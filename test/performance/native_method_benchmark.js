@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Measures the per-call cost of small native methods that do little work
+ * besides checking their receiver, so the cost of crossing into native code
+ * and of the instance check dominates. Run it against two builds of
+ * grpc-native-core to compare them.
+ *
+ * Usage: node native_method_benchmark.js [--iterations=N]
+ * @module
+ */
+
+'use strict';
+
+var _ = require('lodash');
+var minimist = require('minimist');
+
+var grpc = require('../../packages/grpc-native-core/src/grpc_extension');
+
+var argv = minimist(process.argv.slice(2), {
+  default: {iterations: 1000000}
+});
+
+var channel = new grpc.Channel('localhost:1',
+                               grpc.ChannelCredentials.createInsecure());
+var call = channel.createCall('/service/method', Infinity);
+var metadata = new grpc.Metadata();
+metadata.add('key', 'value');
+
+var methods = {
+  'Call.getPeer': function() {
+    call.getPeer();
+  },
+  'Call.cancel': function() {
+    call.cancel();
+  },
+  'Channel.getConnectivityState': function() {
+    channel.getConnectivityState(false);
+  },
+  'Metadata.get': function() {
+    metadata.get('key');
+  },
+  'metadataKeyIsLegal': function() {
+    grpc.metadataKeyIsLegal('key');
+  },
+  'metadataKeyIsBinary': function() {
+    grpc.metadataKeyIsBinary('key-bin');
+  }
+};
+
+function run(name) {
+  var method = methods[name];
+  var start = process.hrtime();
+  for (var i = 0; i < argv.iterations; i++) {
+    method();
+  }
+  var time = process.hrtime(start);
+  var elapsed = time[0] * 1e9 + time[1];
+  console.log(_.padEnd(name, 30) +
+              _.padStart((elapsed / argv.iterations).toFixed(1), 8) +
+              ' ns/call');
+}
+
+// Run each method twice, so that the first runs warm up the JIT
+_.keys(methods).forEach(run);
+_.keys(methods).forEach(run);
+
+call.cancel();
+channel.close();
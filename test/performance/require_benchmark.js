@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Measures how long requiring grpc takes and how much resident memory it
+ * adds, for a process that never makes an RPC and for one that goes on to
+ * create a channel. Each sample runs in a fresh process, since require
+ * results are cached. Run it against two builds of grpc-native-core to
+ * compare them.
+ *
+ * Usage: node require_benchmark.js [--samples=N]
+ * @module
+ */
+
+'use strict';
+
+var childProcess = require('child_process');
+var path = require('path');
+
+var _ = require('lodash');
+var minimist = require('minimist');
+
+var argv = minimist(process.argv.slice(2), {
+  default: {samples: 20}
+});
+
+var grpcPath = path.resolve(__dirname, '../../packages/grpc-native-core');
+
+/* Run in each child. It prints the time that require took in microseconds,
+ * and the resident memory growth in kilobytes, after optionally creating a
+ * channel */
+function childScript(createChannel) {
+  return [
+    'var rssBefore = process.memoryUsage().rss;',
+    'var start = process.hrtime();',
+    'var grpc = require(' + JSON.stringify(grpcPath) + ');',
+    'var time = process.hrtime(start);',
+    createChannel ?
+        'new grpc.Client("localhost:1", grpc.credentials.createInsecure())' +
+        '.close();' : '',
+    'var rss = process.memoryUsage().rss - rssBefore;',
+    'console.log(JSON.stringify({',
+    '  requireUs: time[0] * 1e6 + time[1] / 1e3,',
+    '  rssKb: rss / 1024',
+    '}));'
+  ].join('\n');
+}
+
+function median(values) {
+  var sorted = _.sortBy(values);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+function run(name, createChannel) {
+  var samples = _.times(argv.samples, function() {
+    var output = childProcess.execFileSync(
+        process.execPath, ['-e', childScript(createChannel)]);
+    return JSON.parse(output.toString());
+  });
+  console.log(_.padEnd(name, 16) +
+              '  require ' +
+              _.padStart((median(_.map(samples, 'requireUs')) / 1000)
+                  .toFixed(2), 7) + 'ms' +
+              '  rss +' +
+              _.padStart(median(_.map(samples, 'rssKb')).toFixed(0), 6) +
+              'kB');
+}
+
+run('require only', false);
+run('require+channel', true);
@@ -0,0 +1,103 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Measures TLS handshake throughput by making one unary call on each of a
+ * series of new clients, so that every call needs a new connection. Run it
+ * against builds of grpc-native-core that use different TLS libraries (see
+ * the grpc_ssl build variable), together with require_benchmark.js for load
+ * time and memory.
+ *
+ * Usage: node tls_handshake_benchmark.js [--handshakes=N] [--concurrency=N]
+ * @module
+ */
+
+'use strict';
+
+var fs = require('fs');
+var path = require('path');
+
+var minimist = require('minimist');
+
+var grpc = require('../../packages/grpc-native-core');
+var genericService = require('./generic_service');
+
+var argv = minimist(process.argv.slice(2), {
+  default: {handshakes: 1000, concurrency: 10}
+});
+
+var dataDir = path.join(__dirname, '../../packages/grpc-native-core/test/data');
+var ca = fs.readFileSync(path.join(dataDir, 'ca.pem'));
+var key = fs.readFileSync(path.join(dataDir, 'server1.key'));
+var cert = fs.readFileSync(path.join(dataDir, 'server1.pem'));
+
+var GenericClient = grpc.makeGenericClientConstructor(genericService);
+
+var server = new grpc.Server();
+server.addService(genericService, {
+  unaryCall: function(call, callback) {
+    callback(null, call.request);
+  },
+  streamingCall: function(call) {
+    call.end();
+  }
+});
+var port = server.bind('localhost:0', grpc.ServerCredentials.createSsl(
+    null, [{private_key: key, cert_chain: cert}]));
+server.start();
+
+var clientCreds = grpc.credentials.createSsl(ca);
+var clientOptions = {
+  'grpc.ssl_target_name_override': 'foo.test.google.fr',
+  'grpc.default_authority': 'foo.test.google.fr',
+  // Keep clients from sharing a subchannel, and so a connection
+  'grpc.use_local_subchannel_pool': 1
+};
+var payload = Buffer.alloc(16);
+
+var started = 0;
+var finished = 0;
+var startTime = process.hrtime();
+
+function next() {
+  if (started >= argv.handshakes) {
+    return;
+  }
+  started++;
+  var client = new GenericClient('localhost:' + port, clientCreds,
+                                 clientOptions);
+  client.unaryCall(payload, function(err) {
+    if (err) {
+      throw err;
+    }
+    client.close();
+    finished++;
+    if (finished === argv.handshakes) {
+      var time = process.hrtime(startTime);
+      var seconds = time[0] + time[1] / 1e9;
+      console.log((argv.handshakes / seconds).toFixed(0) + ' handshakes/s');
+      server.forceShutdown();
+    } else {
+      next();
+    }
+  });
+}
+
+for (var i = 0; i < argv.concurrency; i++) {
+  next();
+}
@@ -0,0 +1,166 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * Compares unary and streaming throughput and latency over a Unix domain
+ * socket and over loopback TCP, with the server and client in one process.
+ *
+ * Usage: node uds_benchmark.js [--requests=N] [--concurrency=N]
+ *     [--payload=BYTES]
+ * @module
+ */
+
+'use strict';
+
+var os = require('os');
+var path = require('path');
+
+var _ = require('lodash');
+var minimist = require('minimist');
+
+var grpc = require('../../packages/grpc-native-core');
+var genericService = require('./generic_service');
+var Histogram = require('./histogram');
+
+var argv = minimist(process.argv.slice(2), {
+  default: {requests: 20000, concurrency: 10, payload: 64}
+});
+
+var GenericClient = grpc.makeGenericClientConstructor(genericService);
+
+function startServer(address, creds) {
+  var server = new grpc.Server();
+  server.addService(genericService, {
+    unaryCall: function(call, callback) {
+      callback(null, call.request);
+    },
+    streamingCall: function(call) {
+      call.on('data', function(value) {
+        call.write(value);
+      });
+      call.on('end', function() {
+        call.end();
+      });
+    }
+  });
+  var port = server.bind(address, creds);
+  server.start();
+  return {server: server, port: port};
+}
+
+/**
+ * Runs argv.requests requests with argv.concurrency of them outstanding at a
+ * time. start(done) should issue one request and call done when it finishes.
+ */
+function runRequests(start, callback) {
+  var histogram = new Histogram(0.01, 60e9);
+  var issued = 0;
+  var finished = 0;
+  var startTime = process.hrtime();
+  function next() {
+    if (issued >= argv.requests) {
+      return;
+    }
+    issued++;
+    var requestStart = process.hrtime();
+    start(function(err) {
+      if (err) {
+        throw err;
+      }
+      var elapsed = process.hrtime(requestStart);
+      histogram.add(elapsed[0] * 1e9 + elapsed[1]);
+      finished++;
+      if (finished === argv.requests) {
+        var total = process.hrtime(startTime);
+        callback(histogram, total[0] + total[1] / 1e9);
+      } else {
+        next();
+      }
+    });
+  }
+  for (var i = 0; i < argv.concurrency; i++) {
+    next();
+  }
+}
+
+function runUnary(client, callback) {
+  var payload = Buffer.alloc(argv.payload);
+  runRequests(function(done) {
+    client.unaryCall(payload, done);
+  }, callback);
+}
+
+function runStreaming(client, callback) {
+  var payload = Buffer.alloc(argv.payload);
+  var streams = [];
+  for (var i = 0; i < argv.concurrency; i++) {
+    var stream = client.streamingCall();
+    // The server answers each stream's messages in order
+    stream.waiting = [];
+    stream.on('data', function() {
+      this.waiting.shift()();
+    });
+    streams.push(stream);
+  }
+  var index = 0;
+  runRequests(function(done) {
+    var stream = streams[index];
+    index = (index + 1) % streams.length;
+    stream.waiting.push(done);
+    stream.write(payload);
+  }, function(histogram, seconds) {
+    streams.forEach(function(stream) {
+      stream.end();
+    });
+    callback(histogram, seconds);
+  });
+}
+
+function report(transport, scenario, histogram, seconds) {
+  console.log(_.padEnd(transport, 6) + _.padEnd(scenario, 11) +
+              _.padStart((argv.requests / seconds).toFixed(0), 9) + ' req/s' +
+              '  mean ' + (histogram.mean() / 1000).toFixed(1) + 'us' +
+              '  stddev ' + (histogram.stddev() / 1000).toFixed(1) + 'us');
+}
+
+function runTransport(name, serverAddress, clientAddress, callback) {
+  var creds = grpc.ServerCredentials.createInsecure();
+  var result = startServer(serverAddress, creds);
+  var client = new GenericClient(clientAddress(result.port),
+                                 grpc.credentials.createInsecure());
+  runUnary(client, function(histogram, seconds) {
+    report(name, 'unary', histogram, seconds);
+    runStreaming(client, function(histogram, seconds) {
+      report(name, 'streaming', histogram, seconds);
+      client.close();
+      result.server.forceShutdown();
+      callback();
+    });
+  });
+}
+
+var socketPath = path.join(os.tmpdir(),
+                           'grpc_uds_benchmark_' + process.pid + '.sock');
+
+runTransport('tcp', 'localhost:0', function(port) {
+  return 'localhost:' + port;
+}, function() {
+  runTransport('unix', 'unix:' + socketPath, function() {
+    return 'unix:' + socketPath;
+  }, function() {});
+});